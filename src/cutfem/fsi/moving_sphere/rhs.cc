@@ -31,6 +31,37 @@ namespace cut::fsi::moving_sphere {
         return vel;
     }
 
+    template<int dim>
+    void BoundaryValues<dim>::
+    value_list(const std::vector<Point<dim>> &points,
+               std::vector<Tensor<1, dim>> &values) const {
+        // The velocity of the sphere is the same in all the points, so it is
+        // only computed once.
+        const Tensor<1, dim> vel = level_set->get_velocity();
+        const VectorizedArray<double> zero = make_vectorized_array(0.0);
+        const VectorizedArray<double> one = make_vectorized_array(1.0);
+        utils::evaluate_in_batches(
+                points, values,
+                [&](const Point<dim, VectorizedArray<double>> &p) {
+                    // Zero Dirichlet boundary conditions on the whole
+                    // boundary, as in value().
+                    VectorizedArray<double> inside = one;
+                    for (const double x : {-half_length, half_length}) {
+                        inside = compare_and_apply_mask<SIMDComparison::equal>(
+                                p[0], make_vectorized_array(x), zero, inside);
+                    }
+                    for (const double y : {-radius, radius}) {
+                        inside = compare_and_apply_mask<SIMDComparison::equal>(
+                                p[1], make_vectorized_array(y), zero, inside);
+                    }
+                    Tensor<1, dim, VectorizedArray<double>> val;
+                    for (unsigned int d = 0; d < dim; ++d) {
+                        val[d] = inside * vel[d];
+                    }
+                    return val;
+                });
+    }
+
 
     template<int dim>
     MovingDomain<dim>::MovingDomain(const double half_length,
@@ -52,6 +83,16 @@ namespace cut::fsi::moving_sphere {
         return -sqrt(pow(x - x0, 2) + pow(y - y0, 2)) + sphere_radius;
     }
 
+    template<int dim>
+    VectorizedArray<double> MovingDomain<dim>::
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p) const {
+        const double t = this->get_time();
+        const double x0 = -0.9 * (half_length - sphere_radius) * cos(M_PI * t / 8);
+        const VectorizedArray<double> x = p[0] - x0;
+        const VectorizedArray<double> y = p[1] - y_coord;
+        return sphere_radius - std::sqrt(x * x + y * y);
+    }
+
     template<int dim>
     Tensor<1, dim> MovingDomain<dim>::
     get_velocity() {
@@ -20,6 +20,13 @@ namespace cut::fsi::moving_sphere {
         Tensor<1, dim>
         value(const Point<dim> &p) const override;
 
+        /**
+         * Evaluate the boundary values in all the points, in SIMD batches.
+         */
+        void
+        value_list(const std::vector<Point<dim>> &points,
+                   std::vector<Tensor<1, dim>> &values) const override;
+
     private:
         const double half_length;
         const double radius;
@@ -39,6 +46,9 @@ namespace cut::fsi::moving_sphere {
         double
         value(const Point<dim> &p, unsigned int component) const override;
 
+        VectorizedArray<double>
+        vectorized_value(const Point<dim, VectorizedArray<double>> &p) const override;
+
         Tensor<1, dim>
         get_velocity() override;
 
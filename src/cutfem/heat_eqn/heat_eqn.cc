@@ -54,10 +54,11 @@ namespace examples::cut::HeatEquation {
                           LevelSet<dim> &levelset_func,
                           const bool stabilized,
                           const bool crank_nicholson,
-                          const bool compute_error)
+                          const bool compute_error,
+                          const MPI_Comm &mpi_communicator)
             : ScalarProblem<dim>(n_refines, element_order, write_output,
                                  levelset_func, analytical_soln, stabilized,
-                                 false, compute_error),
+                                 false, compute_error, mpi_communicator),
               nu(nu), radius(radius), half_length(half_length) {
         this->tau = tau;
         this->crank_nicholson = crank_nicholson;
@@ -122,11 +123,8 @@ namespace examples::cut::HeatEquation {
                               this->cut_mesh_classifier,
                               this->constraints);
         if (this->stabilized) {
-            // Object deciding what faces that should be stabilized.
-            std::shared_ptr<Selector<dim>> face_selector(
-                    new Selector<dim>(this->cut_mesh_classifier));
-
-            stabilization.set_faces_to_stabilize(face_selector);
+            // The cached flags deciding what faces that should be stabilized.
+            stabilization.set_faces_to_stabilize(this->stabilized_faces);
             stabilization.set_weight_function(stabilization::taylor_weights);
             const FEValuesExtractors::Scalar velocities(0);
             stabilization.set_extractor(velocities);
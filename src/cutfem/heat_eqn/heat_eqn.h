@@ -57,7 +57,8 @@ namespace examples::cut::HeatEquation {
                 LevelSet<dim> &levelset_func,
                 const bool stabilized = true,
                 const bool crank_nicholson = false,
-                const bool compute_error = true);
+                const bool compute_error = true,
+                const MPI_Comm &mpi_communicator = MPI_COMM_WORLD);
 
         void
         write_header_to_file(std::ofstream &file);
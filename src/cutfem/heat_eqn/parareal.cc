@@ -0,0 +1,67 @@
+#include <deal.II/base/conditional_ostream.h>
+
+#include "../utils/parareal.h"
+#include "heat_eqn.h"
+#include "rhs.h"
+
+
+using namespace examples::cut::HeatEquation;
+
+using utils::problems::CutFEMProblem;
+using utils::problems::Parareal;
+
+
+/**
+ * Solve the heat equation with Parareal, with one time slice for each group
+ * of MPI processes. Run e.g. with
+ *   mpirun -np 8 ./parareal-heat-cutfem
+ * for 8 time slices with one process each.
+ */
+int main(int argc, char *argv[]) {
+    Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+    const int dim = 2;
+    const double radius = 1;
+    const double half_length = 2 * radius;
+    const int n_refines = 5;
+    const int degree = 1;
+    const bool write_output = false;
+
+    const double nu = 2;
+    const double end_time = 1;
+    const unsigned int n_slices =
+            Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+    const double fine_tau = end_time / (n_slices * 16);
+    const double coarse_tau = end_time / n_slices;
+
+    RightHandSide<dim> rhs(nu, fine_tau);
+    BoundaryValues<dim> bdd;
+    AnalyticalSolution<dim> soln;
+    FlowerDomain<dim> domain;
+
+    Parareal<dim> parareal(
+            n_slices, end_time, fine_tau, coarse_tau,
+            [&](const double tau, const MPI_Comm &mpi_communicator)
+                    -> std::unique_ptr<CutFEMProblem<dim>> {
+                return std::make_unique<HeatEqn<dim>>(
+                        nu, tau, radius, half_length, n_refines, degree,
+                        write_output, rhs, bdd, soln, domain, true, false,
+                        true, mpi_communicator);
+            });
+    const unsigned int iterations = parareal.run(1e-8, n_slices);
+
+    ConditionalOStream pcout(
+            std::cout, Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0);
+    pcout << "\nParareal converged in " << iterations << " iterations."
+          << std::endl;
+
+    // Print the error of the last slice, which contains the end time.
+    auto *error = dynamic_cast<ErrorScalar *>(parareal.get_fine_error());
+    if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) + 1 ==
+        Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD)) {
+        std::cout << "Last slice:" << std::endl;
+        std::cout << "|| u - u_h ||_L2 = " << error->l2_error << std::endl;
+        std::cout << "|| u - u_h ||_H1 = " << error->h1_error << std::endl;
+    }
+}
@@ -89,6 +89,13 @@ namespace examples::cut::HeatEquation {
                (r / r0) * cos(5 * atan2(y, x));
     }
 
+    template<int dim>
+    VectorizedArray<double> FlowerDomain<dim>::
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p) const {
+        return utils::flower_levelset_value(p[0] - center_x,
+                                            p[1] - center_y, 0.5, 3.5);
+    }
+
     template<int dim>
     MovingDomain<dim>::MovingDomain(const double sphere_radius,
                                     const double half_length,
@@ -109,9 +116,21 @@ namespace examples::cut::HeatEquation {
     }
 
     template<int dim>
-    double MovingDomain<dim>::
-    get_speed() {
-        return 0.9 * (half_length - sphere_radius) * 2;
+    VectorizedArray<double> MovingDomain<dim>::
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p) const {
+        const double t = this->get_time();
+        const double x0 = 0.9 * (half_length - sphere_radius) * (2 * t - 1);
+        const VectorizedArray<double> x = p[0] - x0;
+        const VectorizedArray<double> y = p[1];
+        return std::sqrt(x * x + y * y) - sphere_radius;
+    }
+
+    template<int dim>
+    Tensor<1, dim> MovingDomain<dim>::
+    get_velocity() {
+        Tensor<1, dim> val;
+        val[0] = 0.9 * (half_length - sphere_radius) * 2;
+        return val;
     }
 
 
@@ -77,6 +77,9 @@ namespace examples::cut::HeatEquation {
         double
         value(const Point<dim> &p, const unsigned int component) const override;
 
+        VectorizedArray<double>
+        vectorized_value(const Point<dim, VectorizedArray<double>> &p) const override;
+
     private:
         const double center_x;
         const double center_y;
@@ -93,8 +96,11 @@ namespace examples::cut::HeatEquation {
         double
         value(const Point<dim> &p, const unsigned int component) const override;
 
-        double
-        get_speed() override;
+        VectorizedArray<double>
+        vectorized_value(const Point<dim, VectorizedArray<double>> &p) const override;
+
+        Tensor<1, dim>
+        get_velocity() override;
 
         const double sphere_radius;
         const double half_length;
@@ -1,7 +1,15 @@
 #include <deal.II/base/point.h>
 
+#include <deal.II/fe/mapping_cartesian.h>
+
+#include <deal.II/grid/grid_generator.h>
+
 #include <deal.II/numerics/vector_tools.h>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include "ns_benchmark.h"
 
 using namespace cutfem;
@@ -25,66 +33,138 @@ namespace examples::cut::NavierStokes::benchmarks {
             nu, tau, radius, half_length, n_refines, element_order,
             write_output, rhs, bdd_values, analytic_vel, analytic_pressure,
             levelset_func, semi_implicit, do_nothing_id, true,
-            stationary, compute_error) {
-        file = std::ofstream(filename);
-        file << "k;t;C_D;C_L;\\Delta p\n" << std::endl;
+            stationary, compute_error),
+              pressure_probes(this->mpi_communicator) {
+        if (this->this_mpi_process == 0) {
+            file = std::ofstream(filename);
+            file << "k;t;C_D;C_L;\\Delta p;C_D (vol);C_L (vol)\n" << std::endl;
+        }
+
+        // Register the points a_1 and a_2 once, the cells containing them are
+        // then only searched for when the dof_handler changes. The points lie
+        // just in front of and behind the cylinder, on the line through its
+        // center in the x-direction (in the plane z = 0 in 3D).
+        Point<dim> a1 = levelset_func.get_center();
+        Point<dim> a2 = levelset_func.get_center();
+        a1[0] -= levelset_func.get_radius();
+        a2[0] += levelset_func.get_radius();
+        pressure_probes.add_point(a1);
+        pressure_probes.add_point(a2);
+    }
+
+
+    template<int dim>
+    void BenchmarkNS<dim>::
+    make_grid(Triangulation<dim> &tria) {
+        this->pcout << "Creating triangulation" << std::endl;
+
+        // Use cells of (close to) equal side lengths.
+        Point<dim> lower_left;
+        Point<dim> upper_right;
+        std::vector<unsigned int> repetitions(dim, 1);
+        lower_left[0] = -this->half_length;
+        upper_right[0] = this->half_length;
+        for (unsigned int d = 1; d < dim; ++d) {
+            lower_left[d] = -this->radius;
+            upper_right[d] = this->radius;
+        }
+        repetitions[0] = std::max(
+                1, (int) std::round(this->half_length / this->radius));
+        GridGenerator::subdivided_hyper_rectangle(tria, repetitions,
+                                                  lower_left, upper_right);
+
+        for (const auto &cell : tria.active_cell_iterators()) {
+            for (const unsigned int f : cell->face_indices()) {
+                if (cell->face(f)->at_boundary()) {
+                    const double x = cell->face(f)->center()[0];
+                    if (std::abs(x + this->half_length) < 1e-10) {
+                        cell->face(f)->set_boundary_id(1);
+                    } else if (std::abs(x - this->half_length) < 1e-10) {
+                        cell->face(f)->set_boundary_id(2);
+                    } else {
+                        cell->face(f)->set_boundary_id(0);
+                    }
+                }
+            }
+        }
+        tria.refine_global(this->n_refines);
+
+        this->mapping_collection.push_back(MappingCartesian<dim>());
     }
 
 
     template<int dim>
     void BenchmarkNS<dim>::
     post_processing(unsigned int time_step) {
-        std::cout << "Post-processing:" << std::endl;
+        this->pcout << "Post-processing:" << std::endl;
 
         // Compute the surface forces. Which are the drag and lift forces
         // respectively. Then these are used for computing the drag and lift
         // coefficients.
         Tensor<1, dim> surface_forces = this->compute_surface_forces();
 
+        // The mean inflow speed of the parabolic profile is 2/3 of the
+        // maximum in 2D, and (2/3)^2 = 4/9 in 3D.
         auto *bdd_values = dynamic_cast<ParabolicFlow<dim> *>(this->boundary_values);
         double max_velocity = bdd_values->get_current_max_speed();
-        double average_speed = 2.0 / 3 * max_velocity;
+        double average_speed = pow(2.0 / 3, dim - 1) * max_velocity;
 
+        // The reference area is the diameter D in 2D, and D * H in 3D, where
+        // H is the height of the channel.
         auto *sphere = dynamic_cast<Sphere<dim> *>(this->levelset_function);
-        double length = 2 * sphere->get_radius();
+        double area = 2 * sphere->get_radius();
+        if (dim == 3) {
+            area *= 2 * this->radius;
+        }
 
         // Compute the drag and lift coefficients.
-        double factor = 2 / (pow(average_speed, 2) * length);
+        double factor = 2 / (pow(average_speed, 2) * area);
         double drag_coefficient = factor * surface_forces[0];
         double lift_coefficient = factor * surface_forces[1];
 
-        std::cout << " * Drag: C_D = " << drag_coefficient << std::endl;
-        std::cout << " * Lift: C_L = " << lift_coefficient << std::endl;
+        this->pcout << " * Drag: C_D = " << drag_coefficient << std::endl;
+        this->pcout << " * Lift: C_L = " << lift_coefficient << std::endl;
+
+        // The residual based forces, with a cut-off function decaying over
+        // the distance of one radius from the cylinder.
+        Tensor<1, dim> volume_forces =
+                this->compute_volume_forces(sphere->get_radius());
+        double volume_drag_coefficient = factor * volume_forces[0];
+        double volume_lift_coefficient = factor * volume_forces[1];
+
+        this->pcout << " * Drag (volume): C_D = " << volume_drag_coefficient
+                    << std::endl;
+        this->pcout << " * Lift (volume): C_L = " << volume_lift_coefficient
+                    << std::endl;
 
         double pressure_diff = compute_pressure_difference();
-        std::cout << " * Δp = " << pressure_diff << std::endl;
+        this->pcout << " * Δp = " << pressure_diff << std::endl;
 
+        if (this->this_mpi_process != 0) {
+            return;
+        }
         file << time_step << ";"
              << this->tau * time_step << ";"
              << drag_coefficient << ";"
              << lift_coefficient << ";"
-             << pressure_diff << std::endl;
+             << pressure_diff << ";"
+             << volume_drag_coefficient << ";"
+             << volume_lift_coefficient << std::endl;
     }
 
     template<int dim>
     double BenchmarkNS<dim>::
     compute_pressure_difference() {
-        Point<dim> a1(0.15 - this->half_length, 0.2 - this->radius);
-        Point<dim> a2(0.25 - this->half_length, 0.2 - this->radius);
-
-        // TODO Use a method that takes a mapping to get higher than only
-        //  Q_1 elements: see VectorTools.
-        Vector<double> value_a1(dim + 1);
-        VectorTools::point_value(*this->dof_handlers.front(),
-                                 this->solutions.front(), a1, value_a1);
-
-        Vector<double> value_a2(dim + 1);
-        VectorTools::point_value(*this->dof_handlers.front(),
-                                 this->solutions.front(), a2, value_a2);
-        return value_a1[dim] - value_a2[dim];
+        std::vector<double> pressure = pressure_probes.evaluate(
+                this->mapping_collection[0], this->dof_handlers.front(),
+                this->solutions.front(), dim);
+        return pressure[0] - pressure[1];
     }
 
     template
     class BenchmarkNS<2>;
 
+    template
+    class BenchmarkNS<3>;
+
 }
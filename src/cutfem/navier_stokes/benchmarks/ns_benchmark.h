@@ -1,6 +1,7 @@
 #ifndef MICROBUBBLE_NS_BENCHMARK_H
 #define MICROBUBBLE_NS_BENCHMARK_H
 
+#include "../../utils/point_probes.h"
 #include "../navier_stokes.h"
 #include "../rhs.h"
 
@@ -13,15 +14,16 @@ namespace examples::cut::NavierStokes::benchmarks {
     using namespace examples::cut;
 
     /**
-     * Class for computing the benchmark tests 2D-1 and 2D-3 at
+     * Class for computing the benchmark tests 2D-1, 2D-3 and 3D-1Z at
      *   http://www.mathematik.tu-dortmund.de/~featflow/en/benchmarks/cfdbenchmarking/flow.html
      *
      * This class implements the method post_processing to compute the pressure
      * difference at the desired points for the tests, and also the drag and
      * lift coefficients.
      *
-     * This test is performed for parabolic flow around a cylinder in a channel
-     * (this implementation implements the 2D case).
+     * This test is performed for parabolic flow around a cylinder in a channel.
+     * In 3D, the channel has a square cross section, and the cylinder spans
+     * it along the z-axis.
      *
      * @tparam dim
      */
@@ -41,16 +43,25 @@ namespace examples::cut::NavierStokes::benchmarks {
                     bool stationary = false, bool compute_error = true);
 
     protected:
+        /**
+         * Create the channel [-half_length, half_length] x
+         * [-radius, radius]^(dim - 1) of cells with (close to) equal side
+         * lengths, with the boundary ids 1 on the inflow boundary, 2 on the
+         * outflow boundary, and 0 on the walls.
+         */
+        void make_grid(Triangulation<dim> &tria) override;
+
         /**
          * Compute the pressure difference between two points in front of and
          * behind the sphere. Also compute the drag and lift coefficients of
-         * sphere.
+         * sphere, both from the surface integral of the traction, and from
+         * the volume integral of the residual (see compute_volume_forces()).
          */
         void post_processing(unsigned int time_step);
 
         /**
          * Compute the pressure difference between the points a_1 and a_2, used in
-         * the benchmarks 2D-1 and 2D-3.
+         * the benchmarks 2D-1, 2D-3 and 3D-1Z.
          * @tparam dim
          * @return
          */
@@ -60,6 +71,9 @@ namespace examples::cut::NavierStokes::benchmarks {
         // Write the computed data to file as csv.
         std::ofstream file;
 
+        // Probes in the points a_1 and a_2 used for the pressure difference.
+        utils::PointProbes<dim> pressure_probes;
+
     };
 }
 
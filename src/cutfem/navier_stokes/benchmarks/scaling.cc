@@ -0,0 +1,108 @@
+#include <deal.II/base/timer.h>
+
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ns_benchmark.h"
+
+using namespace examples::cut::NavierStokes;
+
+
+// The timed sections of CutFEMProblem written to the table.
+const std::vector<std::string> phases = {
+        "level set", "distribute dofs", "initialize matrices", "assembly",
+        "preconditioner setup", "solve"};
+
+
+/**
+ * Run the stationary benchmark (2D-1 or 3D-1Z) once for each refinement
+ * level, and append a row with the wall times of the phases to the file.
+ */
+template<int dim>
+void run_scaling(const unsigned int min_refines,
+                 const unsigned int max_refines,
+                 const std::string &filename) {
+    const unsigned int n_procs = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+    const bool root = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0;
+
+    const unsigned int elementOrder = 1;
+    const double radius = 0.205;
+    const double half_length = dim == 2 ? 1.1 : 1.25;
+    const double center_x = dim == 2 ? 0.2 : 0.5;
+    const double max_speed = dim == 2 ? 0.3 : 0.45;
+    const double nu = 0.001;
+    const double sphere_radius = 0.05;
+
+    std::ofstream file;
+    if (root) {
+        // Write the header only when the file is created, such that the
+        // runs with different numbers of processes fill the same table.
+        const bool new_file = !std::ifstream(filename).good();
+        file.open(filename, std::ios::app);
+        if (new_file) {
+            file << "dim;n_procs;n_refines;n_dofs;total";
+            for (const std::string &phase : phases) {
+                file << ";" << phase;
+            }
+            file << std::endl;
+        }
+    }
+
+    for (unsigned int n_refines = min_refines;
+         n_refines <= max_refines; ++n_refines) {
+        ParabolicFlow<dim> boundary(radius, half_length, max_speed, true);
+        ZeroTensorFunction<1, dim> zero_tensor;
+        Functions::ZeroFunction<dim> zero_scalar;
+        Sphere<dim> domain(sphere_radius, -(half_length - center_x), -0.005);
+
+        benchmarks::BenchmarkNS<dim> ns(
+                nu, 1, radius, half_length, n_refines, elementOrder, false,
+                zero_tensor, boundary, zero_tensor, zero_scalar, domain,
+                "scaling-" + std::to_string(dim) + "D.csv", true, 2, true,
+                false);
+
+        Timer timer(MPI_COMM_WORLD, true);
+        ns.run_step_newton(1e-10);
+        timer.stop();
+
+        const std::map<std::string, double> &timings = ns.get_timings();
+        if (root) {
+            file << dim << ";" << n_procs << ";" << n_refines << ";"
+                 << ns.get_dof_handler()->n_dofs() << ";"
+                 << timer.wall_time();
+            for (const std::string &phase : phases) {
+                const auto timing = timings.find(phase);
+                file << ";" << (timing == timings.end() ? 0 : timing->second);
+            }
+            file << std::endl;
+        }
+    }
+}
+
+
+/**
+ * Scaling runs of the stationary DFG benchmarks. Run as
+ *   mpirun -np <n_procs> bm-scaling <dim> <min_refines> <max_refines> [file]
+ * for each number of processes, or use scaling.py to run the sweep and
+ * compute the parallel efficiencies. For weak scaling, scaling.py --mode weak
+ * ties the refinement level to the number of processes.
+ */
+int main(int argc, char *argv[]) {
+    Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+    const int dim = argc > 1 ? std::stoi(argv[1]) : 2;
+    const unsigned int min_refines = argc > 2 ? std::stoi(argv[2]) : 1;
+    const unsigned int max_refines = argc > 3 ? std::stoi(argv[3]) : min_refines;
+    const std::string filename = argc > 4 ? argv[4] : "scaling.csv";
+
+    if (dim == 2) {
+        run_scaling<2>(min_refines, max_refines, filename);
+    } else if (dim == 3) {
+        run_scaling<3>(min_refines, max_refines, filename);
+    } else {
+        throw std::invalid_argument("The dimension must be 2 or 3.");
+    }
+}
@@ -0,0 +1,199 @@
+import argparse
+import csv
+import math
+import os
+import subprocess
+from collections import defaultdict
+
+# The columns of the table written by bm-scaling, after the run parameters.
+phases = ["total", "level set", "distribute dofs", "initialize matrices",
+          "assembly", "preconditioner setup", "solve"]
+
+
+def run_sweep(executable, mpiexec, n_procs_list, dim, min_refines,
+              max_refines, data_file):
+    """
+    Run bm-scaling once for each number of MPI processes. Each run appends one
+    row for each refinement level to data_file.
+    """
+    if os.path.exists(data_file):
+        os.remove(data_file)
+    for n_procs in n_procs_list:
+        subprocess.run([mpiexec, "-np", str(n_procs), executable, str(dim),
+                        str(min_refines), str(max_refines), data_file],
+                       check=True)
+
+
+def weak_refines(n_procs, dim, min_refines):
+    """
+    Return the number of refinements giving the same number of cells per
+    process as min_refines on one process. A refinement multiplies the number
+    of cells by 2^dim, so n_procs must be a power of 2^dim.
+    """
+    levels = round(math.log(n_procs, 2 ** dim))
+    if (2 ** dim) ** levels != n_procs:
+        raise ValueError(f"Weak scaling in {dim}D needs a number of processes "
+                         f"that is a power of {2 ** dim}, got {n_procs}.")
+    return min_refines + levels
+
+
+def run_weak_sweep(executable, mpiexec, n_procs_list, dim, min_refines,
+                   data_file):
+    """
+    Run bm-scaling once for each number of MPI processes, with the refinement
+    level tied to the number of processes, see weak_refines().
+    """
+    if os.path.exists(data_file):
+        os.remove(data_file)
+    for n_procs in n_procs_list:
+        n_refines = weak_refines(n_procs, dim, min_refines)
+        subprocess.run([mpiexec, "-np", str(n_procs), executable, str(dim),
+                        str(n_refines), str(n_refines), data_file],
+                       check=True)
+
+
+def read_timings(data_file):
+    """
+    Return the rows of the table as a dict (dim, n_refines) -> list of rows,
+    sorted by the number of processes.
+    """
+    runs = defaultdict(list)
+    with open(data_file) as f:
+        for row in csv.DictReader(f, delimiter=";"):
+            runs[(int(row["dim"]), int(row["n_refines"]))].append(row)
+    for rows in runs.values():
+        rows.sort(key=lambda row: int(row["n_procs"]))
+    return runs
+
+
+def write_summary(runs, summary_file):
+    """
+    Compute the strong scaling speedup and parallel efficiency of each phase,
+    relative to the run with the fewest processes on the same mesh:
+      S_p = T_ref / T_p,   E_p = (p_ref T_ref) / (p T_p).
+    """
+    header = ["dim", "n_refines", "n_dofs", "n_procs"]
+    for phase in phases:
+        header += [phase, phase + " speedup", phase + " efficiency"]
+
+    lines = []
+    for (dim, n_refines), rows in sorted(runs.items()):
+        reference = rows[0]
+        p_ref = int(reference["n_procs"])
+        for row in rows:
+            p = int(row["n_procs"])
+            line = [dim, n_refines, row["n_dofs"], p]
+            for phase in phases:
+                t_ref = float(reference[phase])
+                t = float(row[phase])
+                speedup = t_ref / t if t > 0 else float("nan")
+                efficiency = p_ref * speedup / p
+                line += [f"{t:.4g}", f"{speedup:.3f}", f"{efficiency:.3f}"]
+            lines.append(line)
+
+    with open(summary_file, "w") as f:
+        writer = csv.writer(f, delimiter=";")
+        writer.writerow(header)
+        writer.writerows(lines)
+
+    # Print the total wall time and the efficiency of the main phases.
+    columns = ["total", "assembly", "solve"]
+    print(f"{'dim':>4} {'refines':>8} {'n_dofs':>10} {'procs':>6}"
+          + "".join(f" {c + ' [s]':>14} {'E':>6}" for c in columns))
+    for line in lines:
+        dim, n_refines, n_dofs, p = line[:4]
+        values = ""
+        for c in columns:
+            i = 4 + 3 * phases.index(c)
+            values += f" {line[i]:>14} {line[i + 2]:>6}"
+        print(f"{dim:>4} {n_refines:>8} {n_dofs:>10} {p:>6}" + values)
+
+
+def write_weak_summary(data_file, summary_file):
+    """
+    Compute the weak scaling efficiency of each phase, relative to the run
+    with the fewest processes of the same dimension:
+      E_p = T_ref / T_p,
+    which is 1 when the time is constant for a constant load per process.
+    """
+    runs = defaultdict(list)
+    with open(data_file) as f:
+        for row in csv.DictReader(f, delimiter=";"):
+            runs[int(row["dim"])].append(row)
+
+    header = ["dim", "n_refines", "n_dofs", "n_procs", "dofs per proc"]
+    for phase in phases:
+        header += [phase, phase + " efficiency"]
+
+    lines = []
+    for dim, rows in sorted(runs.items()):
+        rows.sort(key=lambda row: int(row["n_procs"]))
+        reference = rows[0]
+        for row in rows:
+            p = int(row["n_procs"])
+            line = [dim, row["n_refines"], row["n_dofs"], p,
+                    int(row["n_dofs"]) // p]
+            for phase in phases:
+                t_ref = float(reference[phase])
+                t = float(row[phase])
+                efficiency = t_ref / t if t > 0 else float("nan")
+                line += [f"{t:.4g}", f"{efficiency:.3f}"]
+            lines.append(line)
+
+    with open(summary_file, "w") as f:
+        writer = csv.writer(f, delimiter=";")
+        writer.writerow(header)
+        writer.writerows(lines)
+
+    columns = ["total", "assembly", "solve"]
+    print(f"{'dim':>4} {'refines':>8} {'n_dofs':>10} {'procs':>6}"
+          f" {'dofs/proc':>10}"
+          + "".join(f" {c + ' [s]':>14} {'E':>6}" for c in columns))
+    for line in lines:
+        dim, n_refines, n_dofs, p, dofs_per_proc = line[:5]
+        values = ""
+        for c in columns:
+            i = 5 + 2 * phases.index(c)
+            values += f" {line[i]:>14} {line[i + 1]:>6}"
+        print(f"{dim:>4} {n_refines:>8} {n_dofs:>10} {p:>6}"
+              f" {dofs_per_proc:>10}" + values)
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description="Sweep the number of MPI processes and the refinement "
+                    "levels of the stationary DFG benchmarks, and write the "
+                    "per-phase timings and parallel efficiencies.")
+    parser.add_argument("--mode", choices=["strong", "weak"],
+                        default="strong",
+                        help="strong: the same meshes on all the numbers of "
+                             "processes. weak: min-refines on one process, "
+                             "and one refinement more for each factor 2^dim "
+                             "in the number of processes.")
+    parser.add_argument("--executable", default="./bm-scaling")
+    parser.add_argument("--mpiexec", default="mpirun")
+    parser.add_argument("--procs", type=int, nargs="+",
+                        help="The numbers of processes. The default is 1, 2, "
+                             "4 and 8 for strong scaling, and 1 and 2^dim "
+                             "for weak scaling.")
+    parser.add_argument("--dim", type=int, default=3)
+    parser.add_argument("--min-refines", type=int, default=1)
+    parser.add_argument("--max-refines", type=int, default=3)
+    parser.add_argument("--data", default="scaling.csv")
+    parser.add_argument("--summary", default="scaling-summary.csv")
+    parser.add_argument("--no-run", action="store_true",
+                        help="Only summarize an existing data file.")
+    args = parser.parse_args()
+
+    if args.mode == "strong":
+        procs = args.procs or [1, 2, 4, 8]
+        if not args.no_run:
+            run_sweep(args.executable, args.mpiexec, procs, args.dim,
+                      args.min_refines, args.max_refines, args.data)
+        write_summary(read_timings(args.data), args.summary)
+    else:
+        procs = args.procs or [1, 2 ** args.dim]
+        if not args.no_run:
+            run_weak_sweep(args.executable, args.mpiexec, procs, args.dim,
+                           args.min_refines, args.data)
+        write_weak_summary(args.data, args.summary)
@@ -42,7 +42,7 @@ int main(int argc, char *argv[]) {
             zero_tensor, boundary, zero_tensor, zero_scalar,
             domain, "benchmark-2D-1.csv", semi_implicit, 2, stationary, false);
 
-    // Solve the equation using fixed point iteration, with a
-    // semi-implicit convection term.
-    ns.run_step_non_linear(1e-10);
+    // Solve the equation using Newton's method, and stop when the residual
+    // is small enough, since no analytical solution is known.
+    ns.run_step_newton(1e-10);
 }
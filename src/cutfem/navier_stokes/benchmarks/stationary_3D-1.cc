@@ -0,0 +1,50 @@
+#include "ns_benchmark.h"
+
+/**
+ * This example is the 3D-1Z benchmark example, flow around a cylinder in a
+ * channel with a square cross section.
+ * See: http://www.mathematik.tu-dortmund.de/~featflow/en/benchmarks/cfdbenchmarking/flow/dfg_flow3d.html
+ *
+ * @return
+ */
+int main(int argc, char *argv[]) {
+    Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+    using namespace examples::cut::NavierStokes;
+    using namespace utils::problems::flow;
+
+    const unsigned int n_refines = 2;
+    const unsigned int elementOrder = 1;
+
+    printf("numRefines=%d\n", n_refines);
+    printf("elementOrder=%d\n", elementOrder);
+    const bool write_vtk = true;
+    const int dim = 3;
+
+    // The channel is [0, 2.5] x [0, 0.41]^2, shifted to be centered at the
+    // origin.
+    const double radius = 0.205;
+    const double half_length = 1.25;
+
+    const double nu = 0.001;
+
+    const bool semi_implicit = true;
+    const bool stationary = true;
+
+    const double max_speed = 0.45;
+    ParabolicFlow<dim> boundary(radius, half_length, max_speed, stationary);
+
+    ZeroTensorFunction<1, dim> zero_tensor;
+    Functions::ZeroFunction<dim> zero_scalar;
+
+    const double sphere_radius = 0.05;
+    Sphere<dim> domain(sphere_radius, -(half_length - 0.5), -0.005);
+
+    benchmarks::BenchmarkNS<dim> ns(
+            nu, 1, radius, half_length, n_refines, elementOrder, write_vtk,
+            zero_tensor, boundary, zero_tensor, zero_scalar,
+            domain, "benchmark-3D-1.csv", semi_implicit, 2, stationary, false);
+
+    // Solve the equation using Newton's method, and stop when the residual
+    // is small enough, since no analytical solution is known.
+    ns.run_step_newton(1e-10);
+}
@@ -63,6 +63,8 @@ void solve_for_element_order(int element_order, int max_refinement,
                                 domain, semi_implicit, 10, true,
                                 true);
 
+        // Accelerate the fixed point iteration, using the last 5 iterates.
+        ns.set_anderson_acceleration(5);
         ErrorBase *err = ns.run_step_non_linear(1e-11);
         auto *error = dynamic_cast<ErrorFlow *>(err);
 
@@ -1,4 +1,5 @@
 #include <deal.II/base/data_out_base.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/quadrature_lib.h>
 
 #include <deal.II/fe/fe_nothing.h>
@@ -19,8 +20,10 @@
 #include <deal.II/numerics/data_out_dof_data.h>
 #include <deal.II/numerics/vector_tools.h>
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
+#include <memory>
 
 #include "../utils/utils.h"
 
@@ -332,10 +335,6 @@ namespace examples::cut::NavierStokes {
         assert(semi_implicit);
         assert(!this->stationary);
 
-        // TODO needed?
-        const hp::FECollection<dim> &fe_collection = this->dof_handlers.front()->get_fe_collection();
-        const hp::QCollection<dim> q_collection(fe_v.get_quadrature());
-
         // Vector for the contribution of each cell
         const unsigned int dofs_per_cell = fe_v.get_fe().dofs_per_cell;
         FullMatrix<double> local_matrix(dofs_per_cell, dofs_per_cell);
@@ -353,39 +352,34 @@ namespace examples::cut::NavierStokes {
 
         // First get a FEValues object that can do calculations over the
         // current cell, but over the solutions in previous time steps.
-        const typename Triangulation<dim>::active_cell_iterator &cell =
-                fe_v.get_cell();
-        hp::FEValues<dim> hp_fe_values(this->mapping_collection,
-                                       fe_collection,
-                                       q_collection,
-                                       update_values);
+        Vector<double> local_dof_values;
+        std::unique_ptr<FEValues<dim>> extension_fe_values;
 
         // Read out the solution values from the previous time steps that we
         // need for the BDF-method.
         for (unsigned long k = 1; k < this->solutions.size(); ++k) {
-            typename hp::DoFHandler<dim>::active_cell_iterator cell_prev(
-                    &(this->triangulation), cell->level(), cell->index(),
-                    this->dof_handlers[k].get());
-            const FiniteElement<dim> &fe = cell_prev->get_fe();
-            if (fe.n_dofs_per_cell() == 0) {
+            const FEValues<dim> *fe_values_prev =
+                    this->get_previous_step_fe_values(k, fe_v,
+                                                      local_dof_values,
+                                                      extension_fe_values);
+            if (fe_values_prev == nullptr) {
                 // This means that in the previous solution step, this cell had
                 // FE_Nothing elements. We can therefore not use that cell to
                 // get the values we need for the BDF-formula. If this happens
                 // then the active mesh in the previous step(s) need to be
                 // extended, such that the cells outside the physical domain
-                // can be stabilized. When the aftive mesh is sufficiently
-                // big in all time steps, we should never enter this clause.
-                // If this happens, the values of 0 vill be used.
+                // can be stabilized, or the previous solutions need to be
+                // extended (see set_extend_previous_solutions()). When the
+                // aftive mesh is sufficiently big in all time steps, we should
+                // never enter this clause. If this happens, the values of 0
+                // vill be used.
                 this->pcout << "# NB: need larger cell buffer outside the "
                              "physical domain, to compute the convection term."
                           << std::endl;
             } else {
                 // Get the function values from the previous time steps.
-                // TODO check that this is actually done.
-                hp_fe_values.reinit(cell_prev);
-                const FEValues<dim> &fe_values_prev = hp_fe_values.get_present_fe_values();
-                fe_values_prev[v].get_function_values(this->solutions[k],
-                                                      prev_solution_values[k]);
+                (*fe_values_prev)[v].get_function_values_from_local_dof_values(
+                        local_dof_values, prev_solution_values[k]);
             }
         }
 
@@ -418,6 +412,169 @@ namespace examples::cut::NavierStokes {
     }
 
 
+    template<int dim>
+    void NavierStokesEqn<dim>::
+    assemble_newton_jacobian() {
+        this->pcout << "Assembling: Navier-Stokes Jacobian" << std::endl;
+
+        // Newton's method is only implemented for the stationary problem.
+        assert(this->stationary);
+        assert(!this->moving_domain);
+
+        NonMatching::RegionUpdateFlags region_update_flags;
+        region_update_flags.inside = update_values | update_JxW_values |
+                                     update_gradients |
+                                     update_quadrature_points;
+
+        NonMatching::FEValues<dim> cut_fe_values(this->mapping_collection,
+                                                 this->fe_collection,
+                                                 this->q_collection,
+                                                 this->q_collection1D,
+                                                 region_update_flags,
+                                                 this->cut_mesh_classifier,
+                                                 this->levelset_dof_handler,
+                                                 this->levelset);
+
+        for (const auto &cell : this->dof_handlers.front()->active_cell_iterators()) {
+            if (cell->is_locally_owned()) {
+                const unsigned int n_dofs = cell->get_fe().dofs_per_cell;
+                const LocationToLevelSet location =
+                        this->cut_mesh_classifier.location_to_level_set(cell);
+                std::vector<types::global_dof_index> loc2glb(n_dofs);
+                cell->get_dof_indices(loc2glb);
+
+                cut_fe_values.reinit(cell);
+
+                if (location != LocationToLevelSet::outside) {
+                    const std_cxx17::optional<FEValues<dim>>& fe_values_bulk =
+                            cut_fe_values.get_inside_fe_values();
+
+                    if (fe_values_bulk) {
+                        assemble_newton_jacobian_over_cell(*fe_values_bulk,
+                                                           loc2glb);
+                    }
+                }
+            }
+        }
+        this->timedep_stiffness_matrix.compress(VectorOperation::add);
+    }
+
+
+    template<int dim>
+    void NavierStokesEqn<dim>::
+    assemble_newton_jacobian_over_cell(
+            const FEValues<dim> &fe_v,
+            const std::vector<types::global_dof_index> &loc2glb) {
+        const unsigned int dofs_per_cell = fe_v.get_fe().dofs_per_cell;
+        FullMatrix<double> local_matrix(dofs_per_cell, dofs_per_cell);
+
+        const FEValuesExtractors::Vector v(0);
+
+        // The values and gradients of the current Newton iterate.
+        std::vector<Tensor<1, dim>> u_values(fe_v.n_quadrature_points);
+        std::vector<Tensor<2, dim>> u_gradients(fe_v.n_quadrature_points);
+        fe_v[v].get_function_values(this->solutions.front(), u_values);
+        fe_v[v].get_function_gradients(this->solutions.front(), u_gradients);
+
+        std::vector<Tensor<2, dim>> grad_phi_u(dofs_per_cell);
+        std::vector<Tensor<1, dim>> phi_u(dofs_per_cell);
+        for (unsigned int q = 0; q < fe_v.n_quadrature_points; ++q) {
+            for (const unsigned int k : fe_v.dof_indices()) {
+                grad_phi_u[k] = fe_v[v].gradient(k, q);
+                phi_u[k] = fe_v[v].value(k, q);
+            }
+
+            for (const unsigned int i : fe_v.dof_indices()) {
+                for (const unsigned int j : fe_v.dof_indices()) {
+                    // Linearization of (u·∇)u = (∇u)u around the iterate u:
+                    // (∇du)u + (∇u)du.
+                    local_matrix(i, j) +=
+                            ((grad_phi_u[j] * u_values[q]
+                              + u_gradients[q] * phi_u[j]) * phi_u[i]) *
+                            this->tau * fe_v.JxW(q);
+                }
+            }
+        }
+        this->timedep_stiffness_matrix.add(loc2glb, local_matrix);
+    }
+
+
+    template<int dim>
+    void NavierStokesEqn<dim>::
+    assemble_nonlinear_terms(LA::MPI::Vector &nonlinear_terms) {
+        assert(this->stationary);
+        assert(!this->moving_domain);
+
+        NonMatching::RegionUpdateFlags region_update_flags;
+        region_update_flags.inside = update_values | update_JxW_values |
+                                     update_gradients |
+                                     update_quadrature_points;
+
+        NonMatching::FEValues<dim> cut_fe_values(this->mapping_collection,
+                                                 this->fe_collection,
+                                                 this->q_collection,
+                                                 this->q_collection1D,
+                                                 region_update_flags,
+                                                 this->cut_mesh_classifier,
+                                                 this->levelset_dof_handler,
+                                                 this->levelset);
+
+        nonlinear_terms = 0;
+        for (const auto &cell : this->dof_handlers.front()->active_cell_iterators()) {
+            if (cell->is_locally_owned()) {
+                const unsigned int n_dofs = cell->get_fe().dofs_per_cell;
+                const LocationToLevelSet location =
+                        this->cut_mesh_classifier.location_to_level_set(cell);
+                std::vector<types::global_dof_index> loc2glb(n_dofs);
+                cell->get_dof_indices(loc2glb);
+
+                cut_fe_values.reinit(cell);
+
+                if (location != LocationToLevelSet::outside) {
+                    const std_cxx17::optional<FEValues<dim>>& fe_values_bulk =
+                            cut_fe_values.get_inside_fe_values();
+
+                    if (fe_values_bulk) {
+                        assemble_nonlinear_terms_over_cell(*fe_values_bulk,
+                                                           loc2glb,
+                                                           nonlinear_terms);
+                    }
+                }
+            }
+        }
+        nonlinear_terms.compress(VectorOperation::add);
+    }
+
+
+    template<int dim>
+    void NavierStokesEqn<dim>::
+    assemble_nonlinear_terms_over_cell(
+            const FEValues<dim> &fe_v,
+            const std::vector<types::global_dof_index> &loc2glb,
+            LA::MPI::Vector &nonlinear_terms) {
+        const unsigned int dofs_per_cell = fe_v.get_fe().dofs_per_cell;
+        Vector<double> local_vector(dofs_per_cell);
+
+        const FEValuesExtractors::Vector v(0);
+
+        std::vector<Tensor<1, dim>> u_values(fe_v.n_quadrature_points);
+        std::vector<Tensor<2, dim>> u_gradients(fe_v.n_quadrature_points);
+        fe_v[v].get_function_values(this->solutions.front(), u_values);
+        fe_v[v].get_function_gradients(this->solutions.front(), u_gradients);
+
+        Tensor<1, dim> convection;
+        for (unsigned int q = 0; q < fe_v.n_quadrature_points; ++q) {
+            // The convection term (u·∇)u = (∇u)u.
+            convection = u_gradients[q] * u_values[q];
+            for (const unsigned int i : fe_v.dof_indices()) {
+                local_vector(i) += convection * fe_v[v].value(i, q)
+                                   * this->tau * fe_v.JxW(q);
+            }
+        }
+        nonlinear_terms.add(loc2glb, local_vector);
+    }
+
+
     template<int dim>
     void NavierStokesEqn<dim>::
     assemble_rhs(int time_step) {
@@ -534,14 +691,20 @@ namespace examples::cut::NavierStokes {
         std::vector<std::vector<Tensor<2, dim>>> prev_gradients(
                 this->solutions.size(), grad_val);
 
-        for (unsigned int k = 1; k < this->solutions.size(); ++k) {
-            fe_v[v].get_function_values(this->solutions[k], prev_values[k]);
-            if (!semi_implicit) {
-                // Then the convection terms should be assembled explicitly,
-                // using the extrapolation from earlier steps, matching the
-                // order of the chosen BDF method.
-                fe_v[v].get_function_gradients(this->solutions[k],
-                                               prev_gradients[k]);
+        // When the BDF-terms are computed with the mass matrix, the previous
+        // solutions are only needed for an explicit convection term.
+        const bool bdf_terms_by_quadrature = !this->bdf_terms_by_mass_matrix;
+        if (bdf_terms_by_quadrature || !semi_implicit) {
+            for (unsigned int k = 1; k < this->solutions.size(); ++k) {
+                fe_v[v].get_function_values(this->solutions[k],
+                                            prev_values[k]);
+                if (!semi_implicit) {
+                    // Then the convection terms should be assembled
+                    // explicitly, using the extrapolation from earlier
+                    // steps, matching the order of the chosen BDF method.
+                    fe_v[v].get_function_gradients(this->solutions[k],
+                                                   prev_gradients[k]);
+                }
             }
         }
 
@@ -568,8 +731,10 @@ namespace examples::cut::NavierStokes {
             }
 
             bdf_terms = Tensor<1, dim>();
-            for (unsigned int k = 1; k < this->solutions.size(); ++k) {
-                bdf_terms += this->bdf_coeffs[k] * prev_values[k][q];
+            if (bdf_terms_by_quadrature) {
+                for (unsigned int k = 1; k < this->solutions.size(); ++k) {
+                    bdf_terms += this->bdf_coeffs[k] * prev_values[k][q];
+                }
             }
             for (const unsigned int i : fe_v.dof_indices()) {
                 phi_u = fe_v[v].value(i, q);
@@ -590,10 +755,6 @@ namespace examples::cut::NavierStokes {
             const FEValues<dim> &fe_v,
             const std::vector<types::global_dof_index> &loc2glb) {
 
-        // TODO needed?
-        const hp::FECollection<dim> &fe_collection = this->dof_handlers.front()->get_fe_collection();
-        const hp::QCollection<dim> q_collection(fe_v.get_quadrature());
-
         // Vector for the contribution of each cell
         const unsigned int dofs_per_cell = fe_v.get_fe().dofs_per_cell;
         Vector<double> local_rhs(dofs_per_cell);
@@ -621,43 +782,38 @@ namespace examples::cut::NavierStokes {
 
         // The the values of the previous solutions, and insert into the
         // matrix initialized above.
-        const typename Triangulation<dim>::active_cell_iterator &cell =
-                fe_v.get_cell();
-        hp::FEValues<dim> hp_fe_values(this->mapping_collection,
-                                       fe_collection,
-                                       q_collection,
-                                       update_values |
-                                       update_gradients);
+        Vector<double> local_dof_values;
+        std::unique_ptr<FEValues<dim>> extension_fe_values;
 
         // Read out the solution values from the previous time steps that we
         // need for the BDF-method
         for (unsigned long k = 1; k < this->solutions.size(); ++k) {
-            typename hp::DoFHandler<dim>::active_cell_iterator cell_prev(
-                    &(this->triangulation), cell->level(), cell->index(),
-                    this->dof_handlers[k].get());
-            const FiniteElement<dim> &fe = cell_prev->get_fe();
-            if (fe.n_dofs_per_cell() == 0) {
+            const FEValues<dim> *fe_values_prev =
+                    this->get_previous_step_fe_values(k, fe_v,
+                                                      local_dof_values,
+                                                      extension_fe_values);
+            if (fe_values_prev == nullptr) {
                 // This means that in the previous solution step, this cell had
                 // FE_Nothing elements. We can therefore not use that cell to
                 // get the values we need for the BDF-formula. If this happens
                 // then the active mesh in the previous step(s) need to be
                 // extended, such that the cells outside the physical domain
-                // can be stabilized. When the aftive mesh is sufficiently
-                // big in all time steps, we should never enter this clause.
-                // If this happens, the values of 0 vill be used.
+                // can be stabilized, or the previous solutions need to be
+                // extended (see set_extend_previous_solutions()). When the
+                // aftive mesh is sufficiently big in all time steps, we should
+                // never enter this clause. If this happens, the values of 0
+                // vill be used.
                 this->pcout << "# NB: need larger cell buffer outside the "
                              "physical domain." << std::endl;
             } else {
                 // Get the function values from the previous time steps.
-                hp_fe_values.reinit(cell_prev);
-                const FEValues<dim> &fe_values_prev = hp_fe_values.get_present_fe_values();
-                fe_values_prev[v].get_function_values(this->solutions[k],
-                                                      prev_values[k]);
+                (*fe_values_prev)[v].get_function_values_from_local_dof_values(
+                        local_dof_values, prev_values[k]);
                 if (!semi_implicit) {
                     // Only needed when the convection term is assembled
                     // exolicitly.
-                    fe_values_prev[v].get_function_gradients(this->solutions[k],
-                                                             prev_gradients[k]);
+                    (*fe_values_prev)[v].get_function_gradients_from_local_dof_values(
+                            local_dof_values, prev_gradients[k]);
                 }
             }
         }
@@ -740,12 +896,150 @@ namespace examples::cut::NavierStokes {
                 }
             }
         }
-        // TODO sum coorectly for MPI
+        // Sum the contributions of the locally owned cells of all the
+        // processes.
         Tensor<1, dim> surface_forces = viscous_forces + pressure_forces;
+        for (unsigned int d = 0; d < dim; ++d) {
+            surface_forces[d] = Utilities::MPI::sum(surface_forces[d],
+                                                    this->mpi_communicator);
+        }
         return surface_forces;
     }
 
 
+    template<int dim>
+    Tensor<1, dim> NavierStokesEqn<dim>::
+    compute_volume_forces(const double cutoff_width) {
+        NonMatching::RegionUpdateFlags region_update_flags;
+        region_update_flags.inside = update_values | update_gradients |
+                                     update_quadrature_points |
+                                     update_JxW_values;
+
+        NonMatching::FEValues<dim> cut_fe_values(this->mapping_collection,
+                                                 this->fe_collection,
+                                                 this->q_collection,
+                                                 this->q_collection1D,
+                                                 region_update_flags,
+                                                 this->cut_mesh_classifier,
+                                                 this->levelset_dof_handler,
+                                                 this->levelset);
+
+        Tensor<1, dim> forces;
+        Vector<double> local_dof_values;
+        std::unique_ptr<FEValues<dim>> extension_fe_values;
+        for (const auto &cell : this->dof_handlers.front()->active_cell_iterators()) {
+            if (cell->is_locally_owned()) {
+                cut_fe_values.reinit(cell);
+                const std_cxx17::optional<FEValues<dim>> &fe_values_inside =
+                        cut_fe_values.get_inside_fe_values();
+                if (fe_values_inside) {
+                    forces += integrate_volume_forces(*fe_values_inside,
+                                                      cutoff_width,
+                                                      local_dof_values,
+                                                      extension_fe_values);
+                }
+            }
+        }
+        for (unsigned int d = 0; d < dim; ++d) {
+            forces[d] = Utilities::MPI::sum(forces[d], this->mpi_communicator);
+        }
+        return forces;
+    }
+
+
+    template<int dim>
+    Tensor<1, dim> NavierStokesEqn<dim>::
+    integrate_volume_forces(const FEValues<dim> &fe_v,
+                            const double cutoff_width,
+                            Vector<double> &local_dof_values,
+                            std::unique_ptr<FEValues<dim>> &extension_fe_values) {
+        const FiniteElement<dim> &fe = fe_v.get_fe();
+        const unsigned int dofs_per_cell = fe.dofs_per_cell;
+        const unsigned int n_q_points = fe_v.n_quadrature_points;
+
+        const FEValuesExtractors::Vector v(0);
+        const FEValuesExtractors::Scalar p(dim);
+
+        std::vector<Tensor<1, dim>> u_values(n_q_points);
+        std::vector<Tensor<2, dim>> u_gradients(n_q_points);
+        std::vector<double> p_values(n_q_points);
+        fe_v[v].get_function_values(this->solutions.front(), u_values);
+        fe_v[v].get_function_gradients(this->solutions.front(), u_gradients);
+        fe_v[p].get_function_values(this->solutions.front(), p_values);
+
+        std::vector<Tensor<1, dim>> rhs_values(n_q_points, Tensor<1, dim>());
+        this->rhs_function->value_list(fe_v.get_quadrature_points(),
+                                       rhs_values);
+
+        // The BDF approximation of the time derivative, as in the assembled
+        // system: ∂_t u ≈ (Σ_k b_k u^k) / τ.
+        std::vector<Tensor<1, dim>> time_derivative(n_q_points,
+                                                    Tensor<1, dim>());
+        if (!this->stationary) {
+            std::vector<Tensor<1, dim>> prev_values(n_q_points);
+            for (unsigned int q = 0; q < n_q_points; ++q) {
+                time_derivative[q] = this->bdf_coeffs[0] * u_values[q];
+            }
+            for (unsigned long k = 1; k < this->solutions.size(); ++k) {
+                const FEValues<dim> *fe_values_prev =
+                        this->get_previous_step_fe_values(
+                                k, fe_v, local_dof_values, extension_fe_values);
+                if (fe_values_prev == nullptr) {
+                    // The values of 0 are used, as in the assembly.
+                    continue;
+                }
+                (*fe_values_prev)[v].get_function_values_from_local_dof_values(
+                        local_dof_values, prev_values);
+                for (unsigned int q = 0; q < n_q_points; ++q) {
+                    time_derivative[q] += this->bdf_coeffs[k] * prev_values[q];
+                }
+            }
+            for (unsigned int q = 0; q < n_q_points; ++q) {
+                time_derivative[q] /= this->tau;
+            }
+        }
+
+        // Interpolate the cut-off function in the support points of the
+        // element.
+        const std::vector<Point<dim>> &unit_points = fe.get_unit_support_points();
+        std::vector<double> cutoff(dofs_per_cell);
+        for (unsigned int i = 0; i < dofs_per_cell; ++i) {
+            const Point<dim> x =
+                    this->mapping_collection[0].transform_unit_to_real_cell(
+                            fe_v.get_cell(), unit_points[i]);
+            const double psi = this->levelset_function->value(x);
+            cutoff[i] = std::min(1.0, std::max(0.0, 1 + psi / cutoff_width));
+        }
+
+        Tensor<1, dim> forces;
+        Vector<double> test_dof_values(dofs_per_cell);
+        std::vector<Tensor<1, dim>> w_values(n_q_points);
+        std::vector<Tensor<2, dim>> w_gradients(n_q_points);
+        for (unsigned int d = 0; d < dim; ++d) {
+            // The test function w = φe_d.
+            for (unsigned int i = 0; i < dofs_per_cell; ++i) {
+                test_dof_values(i) = fe.system_to_component_index(i).first == d
+                                     ? cutoff[i] : 0;
+            }
+            fe_v[v].get_function_values_from_local_dof_values(
+                    test_dof_values, w_values);
+            fe_v[v].get_function_gradients_from_local_dof_values(
+                    test_dof_values, w_gradients);
+
+            for (unsigned int q : fe_v.quadrature_point_indices()) {
+                const double residual =
+                        this->nu * scalar_product(u_gradients[q], w_gradients[q])
+                        - p_values[q] * trace(w_gradients[q])
+                        + (u_gradients[q] * u_values[q]   // (u·∇)u
+                           + time_derivative[q]
+                           - rhs_values[q]) * w_values[q];
+                forces[d] -= residual * fe_v.JxW(q);
+            }
+        }
+        return forces;
+    }
+
+
     template<int dim>
     void NavierStokesEqn<dim>::
     integrate_surface_forces(const FEValuesBase<dim> &fe_v,
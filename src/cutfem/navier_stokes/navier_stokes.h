@@ -93,6 +93,23 @@ namespace examples::cut::NavierStokes {
                 const FEValues<dim> &fe_v,
                 const std::vector<types::global_dof_index> &loc2glb);
 
+        void
+        assemble_newton_jacobian() override;
+
+        void
+        assemble_newton_jacobian_over_cell(
+                const FEValues<dim> &fe_v,
+                const std::vector<types::global_dof_index> &loc2glb);
+
+        void
+        assemble_nonlinear_terms(LA::MPI::Vector &nonlinear_terms) override;
+
+        void
+        assemble_nonlinear_terms_over_cell(
+                const FEValues<dim> &fe_v,
+                const std::vector<types::global_dof_index> &loc2glb,
+                LA::MPI::Vector &nonlinear_terms);
+
         void
         assemble_rhs(int time_step) override;
 
@@ -109,6 +126,39 @@ namespace examples::cut::NavierStokes {
         Tensor<1, dim>
         compute_surface_forces();
 
+        /**
+         * Compute the forces on the immersed body from the weak residual of
+         * the momentum equation, tested with w = φe_i for each direction i,
+         * where φ is a cut-off function equal to 1 on the body (Babuška and
+         * Miller 1984):
+         *   F_i = -[ν(∇u, ∇w) - (p, ∇·w) + ((u·∇)u + ∂_t u - f, w)]_Ω.
+         * The integrals are over the physical domain only, since the Nitsche
+         * and ghost penalty terms of the assembled system would make the
+         * residual vanish for all the discrete test functions. This is a
+         * volume integral over the cells around the body, instead of the
+         * surface integral over the interface in compute_surface_forces().
+         *
+         * The cut-off function is the interpolant of
+         *   φ = min(1, max(0, 1 + ψ/δ)),
+         * where ψ is the level set function, positive in the body. It decays
+         * linearly from the interface to the distance δ into the fluid.
+         *
+         * @param cutoff_width: the width δ of the cut-off function. The
+         * support of φ must not reach the outer boundary.
+         */
+        Tensor<1, dim>
+        compute_volume_forces(double cutoff_width);
+
+        /**
+         * Integrate the residual of the momentum equation over the physical
+         * part of a cell, tested with φe_i for each direction i.
+         */
+        Tensor<1, dim>
+        integrate_volume_forces(const FEValues<dim> &fe_v,
+                                double cutoff_width,
+                                Vector<double> &local_dof_values,
+                                std::unique_ptr<FEValues<dim>> &extension_fe_values);
+
         void
         integrate_surface_forces(const FEValuesBase<dim> &fe_v,
                                  LA::MPI::Vector solution,
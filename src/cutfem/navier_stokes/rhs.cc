@@ -29,6 +29,18 @@ namespace examples::cut::NavierStokes {
         return val;
     }
 
+    template<int dim>
+    void RightHandSide<dim>::
+    value_list(const std::vector<Point<dim>> &points,
+               std::vector<Tensor<1, dim>> &values) const {
+        utils::evaluate_in_batches(
+                points, values,
+                [](const Point<dim, VectorizedArray<double>> &) {
+                    // The rhs is zero, as in value().
+                    return Tensor<1, dim, VectorizedArray<double>>();
+                });
+    }
+
 
     template<int dim>
     ConvectionField<dim>::ConvectionField(const double nu)
@@ -66,6 +78,23 @@ namespace examples::cut::NavierStokes {
         return val;
     }
 
+    template<int dim>
+    void BoundaryValues<dim>::
+    value_list(const std::vector<Point<dim>> &points,
+               std::vector<Tensor<1, dim>> &values) const {
+        const double decay = exp(-2 * pi * pi * nu * this->get_time());
+        utils::evaluate_in_batches(
+                points, values,
+                [decay](const Point<dim, VectorizedArray<double>> &p) {
+                    const VectorizedArray<double> x = pi * p[0];
+                    const VectorizedArray<double> y = pi * p[1];
+                    Tensor<1, dim, VectorizedArray<double>> val;
+                    val[0] = -decay * std::sin(y) * std::cos(x);
+                    val[1] = decay * std::sin(x) * std::cos(y);
+                    return val;
+                });
+    }
+
 
     template<int dim>
     ParabolicFlow<dim>::ParabolicFlow(const double radius,
@@ -96,6 +125,9 @@ namespace examples::cut::NavierStokes {
             // No-slip boundary conditions.
             val[0] = max_speed * (1 - pow(y / radius, 2))
                      * sin(pi * t / 8);
+            if (dim == 3) {
+                val[0] *= 1 - pow(p[2] / radius, 2);
+            }
             // TODO for time dep benchmark, we miss a factor 1.5, set this in
             //  max_speed variable.
             val[1] = 0;
@@ -103,9 +135,36 @@ namespace examples::cut::NavierStokes {
         return val;
     }
 
+    template<int dim>
+    void ParabolicFlow<dim>::
+    value_list(const std::vector<Point<dim>> &points,
+               std::vector<Tensor<1, dim>> &values) const {
+        const double current_max_speed = get_current_max_speed();
+        const VectorizedArray<double> inflow_x =
+                make_vectorized_array(-half_length);
+        const VectorizedArray<double> zero = make_vectorized_array(0.0);
+        utils::evaluate_in_batches(
+                points, values,
+                [&](const Point<dim, VectorizedArray<double>> &p) {
+                    const VectorizedArray<double> y = p[1] / radius;
+                    VectorizedArray<double> profile =
+                            current_max_speed * (1.0 - y * y);
+                    if (dim == 3) {
+                        const VectorizedArray<double> z = p[2] / radius;
+                        profile *= 1.0 - z * z;
+                    }
+                    Tensor<1, dim, VectorizedArray<double>> val;
+                    // The profile is only set on the inflow boundary, as in
+                    // value().
+                    val[0] = compare_and_apply_mask<SIMDComparison::equal>(
+                            p[0], inflow_x, profile, zero);
+                    return val;
+                });
+    }
+
     template<int dim>
     double ParabolicFlow<dim>::
-    get_current_max_speed() {
+    get_current_max_speed() const {
         double t = stationary ? 4 : this->get_time();
         return max_speed * sin(pi * t / 8);
     }
@@ -205,6 +264,18 @@ namespace examples::cut::NavierStokes {
         return -sqrt(pow(x - x0, 2) + pow(y - y0, 2)) + sphere_radius;
     }
 
+    template<int dim>
+    VectorizedArray<double> MovingDomain<dim>::
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p) const {
+        const double t = this->get_time();
+        const double x0 = 0.9 * (half_length - sphere_radius) *
+                          (2 * t / 0.05 - 1);
+        const double y0 = 0.9 * (radius - sphere_radius) * (2 * t / 0.05 - 1);
+        const VectorizedArray<double> x = p[0] - x0;
+        const VectorizedArray<double> y = p[1] - y0;
+        return sphere_radius - std::sqrt(x * x + y * y);
+    }
+
     template<int dim>
     Tensor<1, dim> MovingDomain<dim>::
     get_velocity() {
@@ -232,10 +303,27 @@ namespace examples::cut::NavierStokes {
                sphere_radius;
     }
 
+    template<int dim>
+    VectorizedArray<double> Sphere<dim>::
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p) const {
+        const VectorizedArray<double> x = p[0] - center_x;
+        const VectorizedArray<double> y = p[1] - center_y;
+        return sphere_radius - std::sqrt(x * x + y * y);
+    }
+
     template<int dim>
     double Sphere<dim>::
     get_radius() { return sphere_radius; }
 
+    template<int dim>
+    Point<dim> Sphere<dim>::
+    get_center() const {
+        Point<dim> center;
+        center[0] = center_x;
+        center[1] = center_y;
+        return center;
+    }
+
 
     template
     class RightHandSide<2>;
@@ -249,6 +337,9 @@ namespace examples::cut::NavierStokes {
     template
     class ParabolicFlow<2>;
 
+    template
+    class ParabolicFlow<3>;
+
     template
     class AnalyticalVelocity<2>;
 
@@ -261,4 +352,7 @@ namespace examples::cut::NavierStokes {
     template
     class Sphere<2>;
 
+    template
+    class Sphere<3>;
+
 } // namespace examples::cut::NavierStokes
@@ -23,6 +23,13 @@ namespace examples::cut::NavierStokes {
         Tensor<1, dim>
         value(const Point<dim> &p) const override;
 
+        /**
+         * Evaluate the right hand side in all the points, in SIMD batches.
+         */
+        void
+        value_list(const std::vector<Point<dim>> &points,
+                   std::vector<Tensor<1, dim>> &values) const override;
+
         const double nu;
     };
 
@@ -47,10 +54,23 @@ namespace examples::cut::NavierStokes {
         Tensor<1, dim>
         value(const Point<dim> &p) const override;
 
+        /**
+         * Evaluate the boundary values in all the points, in SIMD batches.
+         */
+        void
+        value_list(const std::vector<Point<dim>> &points,
+                   std::vector<Tensor<1, dim>> &values) const override;
+
         const double nu;
     };
 
 
+    /**
+     * The parabolic inflow profile of the DFG benchmarks, on the inflow
+     * boundary x = -half_length of the channel [-half_length, half_length]
+     * x [-radius, radius]^(dim - 1). In 3D, the profile is the product of
+     * the parabolas in y and z, which gives the 3D-Z benchmarks.
+     */
     template<int dim>
     class ParabolicFlow : public TensorFunction<1, dim> {
     public:
@@ -60,8 +80,15 @@ namespace examples::cut::NavierStokes {
         Tensor<1, dim>
         value(const Point<dim> &p) const override;
 
+        /**
+         * Evaluate the inflow profile in all the points, in SIMD batches.
+         */
+        void
+        value_list(const std::vector<Point<dim>> &points,
+                   std::vector<Tensor<1, dim>> &values) const override;
+
         double
-        get_current_max_speed();
+        get_current_max_speed() const;
 
         const double radius;
         const double half_length;
@@ -111,6 +138,9 @@ namespace examples::cut::NavierStokes {
         double
         value(const Point<dim> &p, unsigned int component) const override;
 
+        VectorizedArray<double>
+        vectorized_value(const Point<dim, VectorizedArray<double>> &p) const override;
+
         Tensor<1, dim>
         get_velocity() override;
 
@@ -121,6 +151,11 @@ namespace examples::cut::NavierStokes {
     };
 
 
+    /**
+     * The level set of a circle in the xy-plane. In 3D, the level set does
+     * not depend on z, so it describes a cylinder along the z-axis, as in the
+     * 3D-Z benchmarks.
+     */
     template<int dim>
     class Sphere : public LevelSet<dim> {
     public :
@@ -131,8 +166,16 @@ namespace examples::cut::NavierStokes {
         double
         value(const Point<dim> &p, unsigned int component) const override;
 
+        VectorizedArray<double>
+        vectorized_value(const Point<dim, VectorizedArray<double>> &p) const override;
+
         double get_radius();
 
+        /**
+         * Return the center of the circle, with z = 0 in 3D.
+         */
+        Point<dim> get_center() const;
+
     private:
         const double sphere_radius;
         const double center_x;
@@ -0,0 +1,74 @@
+#include <deal.II/base/conditional_ostream.h>
+
+#include <fstream>
+#include <memory>
+
+#include "poisson.h"
+#include "rhs.h"
+
+
+using namespace cutfem;
+
+using namespace utils::problems::scalar;
+
+
+/**
+ * Solve the Poisson problem with CG and the geometric multigrid
+ * preconditioner for a sequence of refinements, and write the number of CG
+ * iterations for each mesh size to file. For a preconditioner that is
+ * optimal, the number of iterations is bounded independently of h.
+ */
+template<int dim>
+void multigrid_iterations() {
+    const double radius = 1.1;
+    const double half_length = 1.1;
+    const int degree = 1;
+    const bool write_output = false;
+
+    const unsigned int coarse_refines = 2;
+    const unsigned int max_refines = 7;
+
+    ConditionalOStream pcout(
+            std::cout, Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0);
+
+    RightHandSide<dim> rhs;
+    BoundaryValues<dim> bdd;
+    AnalyticalSolution<dim> soln;
+    FlowerDomain<dim> domain;
+
+    // The levels are the same problem on the coarser meshes.
+    const auto make_level = [&](const unsigned int n_refines)
+            -> std::unique_ptr<CutFEMProblem<dim>> {
+        return std::make_unique<Poisson<dim>>(
+                radius, half_length, n_refines, degree, false,
+                rhs, bdd, soln, domain);
+    };
+
+    std::ofstream file("multigrid-d" + std::to_string(dim)
+                       + "o" + std::to_string(degree) + ".csv");
+    file << "h,n_dofs,iterations,l2_error" << std::endl;
+    for (unsigned int n_refines = coarse_refines + 1;
+         n_refines <= max_refines; ++n_refines) {
+        pcout << "\nn_refines=" << n_refines << std::endl;
+
+        Poisson<dim> poisson(radius, half_length, n_refines, degree,
+                             write_output, rhs, bdd, soln, domain);
+        poisson.set_linear_solver(LinearSolver::cg_gmg, 1e-10);
+        poisson.set_multigrid(make_level, coarse_refines);
+        ErrorBase *err = poisson.run_step();
+        auto *error = dynamic_cast<ErrorScalar *>(err);
+
+        pcout << "CG iterations = " << poisson.get_linear_solver_iterations()
+              << std::endl;
+        file << error->h << ","
+             << poisson.get_dof_handler()->n_dofs() << ","
+             << poisson.get_linear_solver_iterations() << ","
+             << error->l2_error << std::endl;
+    }
+}
+
+
+int main(int argc, char *argv[]) {
+    Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+    multigrid_iterations<2>();
+}
@@ -0,0 +1,92 @@
+#include <deal.II/base/conditional_ostream.h>
+
+#include <fstream>
+
+#include "poisson.h"
+#include "rhs.h"
+
+
+using namespace cutfem;
+
+using namespace utils::problems::scalar;
+
+
+/**
+ * Solve the Poisson problem on a fixed domain for a sweep of the center of
+ * the analytical solution, using a POD reduced basis as the solver. The
+ * basis is built from full order solutions at a few parameters, and then
+ * used to solve the assembled systems for many parameters. The full order
+ * system is still assembled for each parameter, so this is a reduced solver
+ * and not a reduced-order model, see utils::ReducedBasis. The error estimate
+ * of the reduced basis and the errors against the analytical solution are
+ * written to file.
+ */
+template<int dim>
+void reduced_basis_sweep() {
+    const double radius = 1;
+    const double half_length = 1;
+    const int n_refines = 5;
+    const int degree = 1;
+    const bool write_output = false;
+
+    const double max_center = 0.2;
+    const unsigned int n_training = 10;
+    const unsigned int n_sweep = 100;
+
+    ConditionalOStream pcout(
+            std::cout, Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0);
+
+    // The domain must be the same in all the runs, such that all the
+    // solutions use the same dofs.
+    Sphere<dim> domain(0.9 * radius, 0, 0);
+
+    utils::ReducedBasis<LA::MPI::Vector> reduced_basis(1e-10, 30);
+
+    // Training: full order solves.
+    for (unsigned int k = 0; k < n_training; ++k) {
+        const double center = max_center * k / (n_training - 1);
+        RightHandSide<dim> rhs(center, center);
+        BoundaryValues<dim> bdd(center, center);
+        AnalyticalSolution<dim> soln(center, center);
+
+        Poisson<dim> poisson(radius, half_length, n_refines, degree,
+                             write_output, rhs, bdd, soln, domain);
+        poisson.set_snapshot_collector(&reduced_basis);
+        poisson.run_step();
+    }
+    reduced_basis.compute_basis();
+    pcout << "\nReduced basis: " << reduced_basis.size() << " modes from "
+          << reduced_basis.n_snapshots() << " snapshots, truncation error = "
+          << reduced_basis.get_truncation_error() << std::endl;
+
+    // The sweep: the systems are assembled, and solved in the reduced basis.
+    std::ofstream file("reduced-basis-d" + std::to_string(dim)
+                       + "o" + std::to_string(degree)
+                       + "r" + std::to_string(n_refines) + ".csv");
+    file << "k,center,estimate,l2_error,h1_error" << std::endl;
+    for (unsigned int k = 0; k <= n_sweep; ++k) {
+        const double center = max_center * k / n_sweep;
+        RightHandSide<dim> rhs(center, center);
+        BoundaryValues<dim> bdd(center, center);
+        AnalyticalSolution<dim> soln(center, center);
+
+        Poisson<dim> poisson(radius, half_length, n_refines, degree,
+                             write_output, rhs, bdd, soln, domain);
+        poisson.set_reduced_basis(&reduced_basis);
+        ErrorBase *err = poisson.run_step();
+        auto *error = dynamic_cast<ErrorScalar *>(err);
+
+        file << k << ","
+             << center << ","
+             << poisson.get_reduced_basis_estimate() << ","
+             << error->l2_error << ","
+             << error->h1_error << std::endl;
+    }
+}
+
+
+int main(int argc, char *argv[]) {
+    Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+    const int dim = 2;
+    reduced_basis_sweep<dim>();
+}
@@ -78,6 +78,13 @@ value(const Point<dim> &p, const unsigned int component) const {
     return sqrt(pow(x, 2) + pow(y, 2)) - r + (r / r0) * cos(5 * atan2(y, x));
 }
 
+template<int dim>
+VectorizedArray<double> FlowerDomain<dim>::
+vectorized_value(const Point<dim, VectorizedArray<double>> &p) const {
+    return utils::flower_levelset_value(p[0] - center_x, p[1] - center_y,
+                                        0.5, 3.5);
+}
+
 
 template<int dim>
 Sphere<dim>::Sphere(const double sphere_radius,
@@ -96,6 +103,14 @@ value(const Point<dim> &p, const unsigned int component) const {
             sphere_radius;
 }
 
+template<int dim>
+VectorizedArray<double> Sphere<dim>::
+vectorized_value(const Point<dim, VectorizedArray<double>> &p) const {
+    const VectorizedArray<double> x = p[0] - center_x;
+    const VectorizedArray<double> y = p[1] - center_y;
+    return std::sqrt(x * x + y * y) - sphere_radius;
+}
+
 template<int dim>
 double Sphere<dim>::
 get_radius() { return sphere_radius; }
@@ -68,6 +68,9 @@ public :
     double
     value(const Point<dim> &p, const unsigned int component) const override;
 
+    VectorizedArray<double>
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p) const override;
+
 private:
     const double center_x;
     const double center_y;
@@ -84,6 +87,9 @@ public :
     double
     value(const Point<dim> &p, unsigned int component) const override;
 
+    VectorizedArray<double>
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p) const override;
+
     double get_radius();
 
 private:
@@ -43,6 +43,12 @@ namespace examples::cut::projections {
     using NonMatching::LocationToLevelSet;
     using namespace utils::problems::flow;
 
+    /**
+     * Compute the L2-projection of the analytical velocity and pressure onto
+     * the cut finite element space. The ghost penalty stabilized mass matrix
+     * is solved with CG and a Jacobi preconditioner, see
+     * CutFEMProblem::project_onto_cut_space().
+     */
     template<int dim>
     class ProjectionFlow : public FlowProblem<dim> {
     public:
@@ -69,13 +75,7 @@ namespace examples::cut::projections {
         assemble_system() override;
 
         void
-        assemble_local_over_cell(const FEValues<dim> &fe_values,
-                                 const std::vector<types::global_dof_index> &loc2glb) override;
-
-        void
-        assemble_local_over_surface(
-                const FEValuesBase<dim> &fe_values,
-                const std::vector<types::global_dof_index> &loc2glb) override;
+        solve() override;
 
         const double radius;
         const double half_length;
@@ -1,12 +1,11 @@
-#include "cutfem/geometry/SignedDistanceSphere.h"
-
 #include "projection_flow.h"
 
 using namespace examples::cut::projections;
 using namespace utils::problems::flow;
 using namespace cutfem;
 
-int main() {
+int main(int argc, char *argv[]) {
+    Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
     const unsigned int n_refines = 4;
     const unsigned int elementOrder = 1;
 
@@ -4,8 +4,12 @@
 #include <deal.II/base/function.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/tensor_function.h>
+#include <deal.II/base/vectorization.h>
+
+#include "../utils/cutfem_problem.h"
 
 using namespace dealii;
+using namespace utils::problems;
 
 
 template<int dim>
@@ -44,4 +48,24 @@ protected:
 };
 
 
+
+template<int dim>
+class Sphere : public LevelSet<dim> {
+public :
+    Sphere(double sphere_radius,
+           double center_x,
+           double center_y);
+
+    double
+    value(const Point<dim> &p, unsigned int component) const override;
+
+    VectorizedArray<double>
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p) const override;
+
+private:
+    const double sphere_radius;
+    const double center_x;
+    const double center_y;
+};
+
 #endif // MICROBUBBLE_STOKESRHS_H
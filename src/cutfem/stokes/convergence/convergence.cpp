@@ -2,11 +2,12 @@
 #include <iostream>
 #include <vector>
 
-#include "../error/ErrorStokesCylinder.h"
+#include "../error/ErrorRhs.h"
 
 template<int dim>
 void solve_for_element_order(int element_order, int max_refinement,
                              bool write_output) {
+    using utils::problems::flow::ErrorFlow;
 
     double radius = 0.205;
     double half_length = 0.205;
@@ -17,7 +18,6 @@ void solve_for_element_order(int element_order, int max_refinement,
 
     std::ofstream file("errors-d" + std::to_string(dim)
                        + "o" + std::to_string(element_order) + ".csv");
-    ErrorStokesCylinder<dim>::write_header_to_file(file);
 
     ErrorStokesRhs<dim> stokes_rhs(radius, 2 * half_length, pressure_drop);
     ErrorBoundaryValues<dim> boundary_values(radius, 2 * half_length,
@@ -26,23 +26,25 @@ void solve_for_element_order(int element_order, int max_refinement,
                                                 pressure_drop, sphere_x_coord,
                                                 sphere_radius);
     AnalyticalPressure<dim> analytical_pressure;
+    Sphere<dim> domain(sphere_radius, sphere_x_coord, 0);
 
     for (int n_refines = 1; n_refines < max_refinement + 1; ++n_refines) {
         std::cout << "\nn_refines=" << n_refines << std::endl;
 
-        ErrorStokesCylinder<dim> stokes(radius, half_length, n_refines,
-                                        element_order,
-                                        write_output, stokes_rhs,
-                                        boundary_values, analytical_solution,
-                                        analytical_pressure, pressure_drop,
-                                        sphere_radius, sphere_x_coord);
-        stokes.run();
-        Error error = stokes.compute_error();
-        std::cout << "|| u - u_h ||_L2 = " << error.l2_error_u << std::endl;
-        std::cout << "|| u - u_h ||_H1 = " << error.h1_error_u << std::endl;
-        std::cout << "|| p - p_h ||_L2 = " << error.l2_error_p << std::endl;
-        std::cout << "|| p - p_h ||_H1 = " << error.h1_error_p << std::endl;
-        ErrorStokesCylinder<dim>::write_error_to_file(error, file);
+        StokesCylinder<dim> stokes(radius, half_length, n_refines,
+                                   element_order, write_output, stokes_rhs,
+                                   boundary_values, analytical_solution,
+                                   analytical_pressure, domain, true);
+        if (n_refines == 1) {
+            stokes.write_header_to_file(file);
+        }
+        ErrorBase *err = stokes.run_step();
+        auto *error = dynamic_cast<ErrorFlow *>(err);
+        std::cout << "|| u - u_h ||_L2 = " << error->l2_error_u << std::endl;
+        std::cout << "|| u - u_h ||_H1 = " << error->h1_error_u << std::endl;
+        std::cout << "|| p - p_h ||_L2 = " << error->l2_error_p << std::endl;
+        std::cout << "|| p - p_h ||_H1 = " << error->h1_error_p << std::endl;
+        stokes.write_error_to_file(err, file);
     }
 }
 
@@ -57,7 +59,8 @@ void run_convergence_test(std::vector<int> orders, int max_refinement,
 }
 
 
-int main() {
+int main(int argc, char *argv[]) {
+    Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
 
     run_convergence_test<2>({1, 2}, 7, true);
 
@@ -93,14 +93,4 @@ public:
 };
 
 
-struct Error {
-    double mesh_size = 0;
-    double l2_error_u = 0;
-    double h1_error_u = 0;
-    double h1_semi_u = 0;
-    double l2_error_p = 0;
-    double h1_error_p = 0;
-    double h1_semi_p = 0;
-};
-
 #endif // MOCROBUBBLE_ERRORRHS_H
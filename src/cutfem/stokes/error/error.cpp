@@ -1,9 +1,12 @@
 #include <iostream>
 
-#include "ErrorStokesCylinder.h"
+#include "ErrorRhs.h"
 
 
-int main() {
+int main(int argc, char *argv[]) {
+    Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+    using utils::problems::flow::ErrorFlow;
+
     const unsigned int n_refines = 4;
     const unsigned int elementOrder = 1;
 
@@ -27,21 +30,20 @@ int main() {
                                                pressure_drop, sphere_x_coord,
                                                sphere_radius);
     AnalyticalPressure<dim> analyticalPressure;
-
-    ErrorStokesCylinder<dim> stokes(radius, half_length, n_refines,
-                                    elementOrder,
-                                    write_vtk, stokesRhs, boundaryValues,
-                                    analyticalSolution, analyticalPressure,
-                                    pressure_drop, sphere_radius,
-                                    sphere_x_coord);
-    stokes.run();
-    Error error = stokes.compute_error();
-
-    std::cout << "Mesh size: " << error.mesh_size << std::endl;
-    std::cout << "|| u - u_h ||_L2 = " << error.l2_error_u << std::endl;
-    std::cout << "|| u - u_h ||_H1 = " << error.h1_error_u << std::endl;
-    std::cout << "| u - u_h |_H1 = " << error.h1_semi_u << std::endl;
-    std::cout << "|| p - p_h ||_L2 = " << error.l2_error_p << std::endl;
-    std::cout << "|| p - p_h ||_H1 = " << error.h1_error_p << std::endl;
-    std::cout << "| p - p_h |_H1 = " << error.h1_semi_p << std::endl;
+    Sphere<dim> domain(sphere_radius, sphere_x_coord, 0);
+
+    StokesCylinder<dim> stokes(radius, half_length, n_refines, elementOrder,
+                               write_vtk, stokesRhs, boundaryValues,
+                               analyticalSolution, analyticalPressure, domain,
+                               true);
+    ErrorBase *err = stokes.run_step();
+    auto *error = dynamic_cast<ErrorFlow *>(err);
+
+    std::cout << "Mesh size: " << error->h << std::endl;
+    std::cout << "|| u - u_h ||_L2 = " << error->l2_error_u << std::endl;
+    std::cout << "|| u - u_h ||_H1 = " << error->h1_error_u << std::endl;
+    std::cout << "| u - u_h |_H1 = " << error->h1_semi_u << std::endl;
+    std::cout << "|| p - p_h ||_L2 = " << error->l2_error_p << std::endl;
+    std::cout << "|| p - p_h ||_H1 = " << error->h1_error_p << std::endl;
+    std::cout << "| p - p_h |_H1 = " << error->h1_semi_p << std::endl;
 }
@@ -1,4 +1,5 @@
 #include <deal.II/base/point.h>
+#include <deal.II/base/tensor_function.h>
 
 #include <cstdio>
 #include <cstdlib>
@@ -7,7 +8,9 @@
 #include "../StokesCylinder.h"
 
 int
-main() {
+main(int argc, char *argv[]) {
+    Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
     const unsigned int n_refines = 6;
     const int elementOrder = 1;
 
@@ -24,9 +27,14 @@ main() {
 
     StokesRhs<dim> stokesRhs;
     BoundaryValues<dim> boundaryValues(radius, 2 * half_length);
+    Sphere<dim> domain(sphere_radius, sphere_x_coord, 0);
+
+    // There is no analytical solution, so the errors are not computed.
+    ZeroTensorFunction<1, dim> zero_velocity;
+    Functions::ZeroFunction<dim> zero_pressure;
 
     StokesCylinder<dim> s(radius, half_length, n_refines, elementOrder,
-                          write_vtk, stokesRhs, boundaryValues, sphere_radius,
-                          sphere_x_coord);
-    s.run();
+                          write_vtk, stokesRhs, boundaryValues, zero_velocity,
+                          zero_pressure, domain);
+    s.run_step();
 }
@@ -21,28 +21,31 @@ void solve_for_element_order(int element_order, int max_refinement,
 
     std::ofstream file("errors-d" + std::to_string(dim)
                        + "o" + std::to_string(element_order) + ".csv");
-    StokesCylinder<dim>::write_header_to_file(file);
 
     RightHandSide<dim> rhs(delta, nu, tau);
     BoundaryValues<dim> boundary_values;
     AnalyticalVelocity<dim> analytical_velocity;
     AnalyticalPressure<dim> analytical_pressure;
+    Sphere<dim> domain(sphere_radius, sphere_x_coord, 0);
 
     for (int n_refines = 1; n_refines < max_refinement + 1; ++n_refines) {
         std::cout << "\nn_refines=" << n_refines << std::endl;
 
-        StokesCylinder<dim> stokes(radius, half_length, n_refines, delta, nu,
-                                   tau, element_order, write_output, rhs,
-                                   boundary_values, analytical_velocity,
-                                   analytical_pressure,
-                                   sphere_radius, sphere_x_coord);
-        Error error = stokes.run();
-
-        std::cout << "|| u - u_h ||_L2 = " << error.l2_error_u << std::endl;
-        std::cout << "|| u - u_h ||_H1 = " << error.h1_error_u << std::endl;
-        std::cout << "|| p - p_h ||_L2 = " << error.l2_error_p << std::endl;
-        std::cout << "|| p - p_h ||_H1 = " << error.h1_error_p << std::endl;
-        StokesCylinder<dim>::write_error_to_file(error, file);
+        GeneralizedStokesEqn<dim> stokes(delta, nu, tau, radius, half_length,
+                                         n_refines, element_order,
+                                         write_output, rhs, boundary_values,
+                                         analytical_velocity,
+                                         analytical_pressure, domain);
+        if (n_refines == 1) {
+            stokes.write_header_to_file(file);
+        }
+        ErrorBase *err = stokes.run_step();
+        auto *error = dynamic_cast<ErrorFlow *>(err);
+        std::cout << "|| u - u_h ||_L2 = " << error->l2_error_u << std::endl;
+        std::cout << "|| u - u_h ||_H1 = " << error->h1_error_u << std::endl;
+        std::cout << "|| p - p_h ||_L2 = " << error->l2_error_p << std::endl;
+        std::cout << "|| p - p_h ||_H1 = " << error->h1_error_p << std::endl;
+        stokes.write_error_to_file(err, file);
     }
 }
 
@@ -57,7 +60,8 @@ void run_convergence_test(std::vector<int> orders, int max_refinement,
 }
 
 
-int main() {
+int main(int argc, char *argv[]) {
+    Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
 
     run_convergence_test<2>({1, 2}, 8, true);
 
@@ -4,20 +4,15 @@
 #include <deal.II/base/function.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/tensor_function.h>
+#include <deal.II/base/vectorization.h>
+
+#include "../utils/cutfem_problem.h"
 
 using namespace dealii;
 
 namespace GeneralizedStokes {
 
-    struct Error {
-        double mesh_size = 0;
-        double l2_error_u = 0;
-        double h1_error_u = 0;
-        double h1_semi_u = 0;
-        double l2_error_p = 0;
-        double h1_error_p = 0;
-        double h1_semi_p = 0;
-    };
+    using namespace utils::problems;
 
     template<int dim>
     class RightHandSide : public TensorFunction<1, dim> {
@@ -63,6 +58,31 @@ namespace GeneralizedStokes {
                  const unsigned int component) const override;
     };
 
+
+    /**
+     * The channel with a sphere removed. The level set is positive inside
+     * the sphere, so the domain Ω is the part of the background mesh outside
+     * of it.
+     */
+    template<int dim>
+    class Sphere : public LevelSet<dim> {
+    public :
+        Sphere(double sphere_radius,
+               double center_x,
+               double center_y);
+
+        double
+        value(const Point<dim> &p, unsigned int component) const override;
+
+        VectorizedArray<double>
+        vectorized_value(const Point<dim, VectorizedArray<double>> &p) const override;
+
+    private:
+        const double sphere_radius;
+        const double center_x;
+        const double center_y;
+    };
+
 }
 
 
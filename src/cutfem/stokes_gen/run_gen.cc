@@ -1,7 +1,8 @@
 #include "stokes_gen.h"
 
 
-int main() {
+int main(int argc, char *argv[]) {
+    Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
     using namespace GeneralizedStokes;
 
     const unsigned int n_refines = 4;
@@ -28,16 +29,19 @@ int main() {
     AnalyticalVelocity<dim> analytical_velocity;
     AnalyticalPressure<dim> analytical_pressure;
 
-    StokesCylinder<dim> stokes(radius, half_length, n_refines, delta, nu, tau,
-                               elementOrder, write_vtk, rhs, boundary,
-                               analytical_velocity, analytical_pressure,
-                               sphere_radius, sphere_x_coord);
-    Error error = stokes.run();
-    std::cout << "Mesh size: " << error.mesh_size << std::endl;
-    std::cout << "|| u - u_h ||_L2 = " << error.l2_error_u << std::endl;
-    std::cout << "|| u - u_h ||_H1 = " << error.h1_error_u << std::endl;
-    std::cout << "| u - u_h |_H1 = " << error.h1_semi_u << std::endl;
-    std::cout << "|| p - p_h ||_L2 = " << error.l2_error_p << std::endl;
-    std::cout << "|| p - p_h ||_H1 = " << error.h1_error_p << std::endl;
-    std::cout << "| p - p_h |_H1 = " << error.h1_semi_p << std::endl;
+    Sphere<dim> domain(sphere_radius, sphere_x_coord, 0);
+
+    GeneralizedStokesEqn<dim> stokes(delta, nu, tau, radius, half_length,
+                                     n_refines, elementOrder, write_vtk, rhs,
+                                     boundary, analytical_velocity,
+                                     analytical_pressure, domain);
+    ErrorBase *err = stokes.run_step();
+    auto *error = dynamic_cast<ErrorFlow *>(err);
+    std::cout << "Mesh size: " << error->h << std::endl;
+    std::cout << "|| u - u_h ||_L2 = " << error->l2_error_u << std::endl;
+    std::cout << "|| u - u_h ||_H1 = " << error->h1_error_u << std::endl;
+    std::cout << "| u - u_h |_H1 = " << error->h1_semi_u << std::endl;
+    std::cout << "|| p - p_h ||_L2 = " << error->l2_error_p << std::endl;
+    std::cout << "|| p - p_h ||_H1 = " << error->h1_error_p << std::endl;
+    std::cout << "| p - p_h |_H1 = " << error->h1_semi_p << std::endl;
 }
@@ -2,12 +2,15 @@
 #include <iostream>
 #include <vector>
 
-#include "stokes_gen.h"
+#include "../stokes_time2/stokes.h"
+#include "rhs_gen.h"
 
 template<int dim>
 void solve_for_element_order(int element_order, int max_refinement,
                              bool write_output) {
     using namespace TimeDependentStokesIE;
+    using examples::cut::StokesEquation::StokesEqn;
+    using utils::problems::flow::ErrorFlow;
 
     double radius = 0.205 / 2;
     double half_length = 0.205 / 2;
@@ -24,11 +27,11 @@ void solve_for_element_order(int element_order, int max_refinement,
 
     std::ofstream file("errors-d" + std::to_string(dim)
                        + "o" + std::to_string(element_order) + ".csv");
-    StokesCylinder<dim>::write_header_to_file(file);
 
     BoundaryValues<dim> boundary_values(nu);
     AnalyticalVelocity<dim> analytical_velocity(nu);
     AnalyticalPressure<dim> analytical_pressure(nu);
+    Sphere<dim> domain(sphere_radius, sphere_x_coord, 0);
 
     for (int n_refines = 1; n_refines < max_refinement + 1; ++n_refines) {
         std::cout << "\nn_refines=" << n_refines << std::endl;
@@ -37,23 +40,26 @@ void solve_for_element_order(int element_order, int max_refinement,
         tau = tau_init / pow(2, n_refines - 1);
         RightHandSide<dim> rhs(delta, nu, tau);
 
-        StokesCylinder<dim> stokes(radius, half_length, n_refines, nu,
-                                   tau, element_order, write_output, rhs,
-                                   boundary_values, analytical_velocity,
-                                   analytical_pressure,
-                                   sphere_radius, sphere_x_coord);
+        StokesEqn<dim> stokes(nu, tau, radius, half_length, n_refines,
+                              element_order, write_output, rhs,
+                              boundary_values, analytical_velocity,
+                              analytical_pressure, domain);
+        if (n_refines == 1) {
+            stokes.write_header_to_file(file);
+        }
 
         double n_steps = end_time / tau;
         std::cout << "T = " << end_time << ", tau = " << tau
                   << ", steps = " << n_steps << std::endl;
 
-        Error error = stokes.run(n_steps);
+        ErrorBase *err = stokes.run_time(1, n_steps);
+        auto *error = dynamic_cast<ErrorFlow *>(err);
 
-        std::cout << "|| u - u_h ||_L2 = " << error.l2_error_u << std::endl;
-        std::cout << "|| u - u_h ||_H1 = " << error.h1_error_u << std::endl;
-        std::cout << "|| p - p_h ||_L2 = " << error.l2_error_p << std::endl;
-        std::cout << "|| p - p_h ||_H1 = " << error.h1_error_p << std::endl;
-        StokesCylinder<dim>::write_error_to_file(error, file);
+        std::cout << "|| u - u_h ||_L2 = " << error->l2_error_u << std::endl;
+        std::cout << "|| u - u_h ||_H1 = " << error->h1_error_u << std::endl;
+        std::cout << "|| p - p_h ||_L2 = " << error->l2_error_p << std::endl;
+        std::cout << "|| p - p_h ||_H1 = " << error->h1_error_p << std::endl;
+        stokes.write_error_to_file(err, file);
     }
 }
 
@@ -68,7 +74,8 @@ void run_convergence_test(std::vector<int> orders, int max_refinement,
 }
 
 
-int main() {
+int main(int argc, char *argv[]) {
+    Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
 
     run_convergence_test<2>({1}, 9, true);
 
@@ -120,6 +120,32 @@ namespace TimeDependentStokesIE {
         return value;
     }
 
+
+    template<int dim>
+    Sphere<dim>::Sphere(const double sphere_radius,
+                        const double center_x,
+                        const double center_y)
+            : sphere_radius(sphere_radius), center_x(center_x),
+              center_y(center_y) {}
+
+    template<int dim>
+    double Sphere<dim>::
+    value(const Point<dim> &p, const unsigned int component) const {
+        (void) component;
+        double x = p[0];
+        double y = p[1];
+        return -sqrt(pow(x - center_x, 2) + pow(y - center_y, 2)) +
+               sphere_radius;
+    }
+
+    template<int dim>
+    VectorizedArray<double> Sphere<dim>::
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p) const {
+        const VectorizedArray<double> x = p[0] - center_x;
+        const VectorizedArray<double> y = p[1] - center_y;
+        return sphere_radius - std::sqrt(x * x + y * y);
+    }
+
     template
     class RightHandSide<2>;
 
@@ -132,4 +158,7 @@ namespace TimeDependentStokesIE {
     template
     class AnalyticalPressure<2>;
 
+    template
+    class Sphere<2>;
+
 } // namespace TimeDependentStokesIE
\ No newline at end of file
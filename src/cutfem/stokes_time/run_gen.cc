@@ -1,8 +1,12 @@
-#include "stokes_gen.h"
+#include "../stokes_time2/stokes.h"
+#include "rhs_gen.h"
 
 
-int main() {
+int main(int argc, char *argv[]) {
+    Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
     using namespace TimeDependentStokesIE;
+    using examples::cut::StokesEquation::StokesEqn;
+    using utils::problems::flow::ErrorFlow;
 
     const unsigned int n_refines = 5;
     const unsigned int elementOrder = 1;
@@ -29,16 +33,20 @@ int main() {
     AnalyticalVelocity<dim> analytical_velocity(nu);
     AnalyticalPressure<dim> analytical_pressure(nu);
 
-    StokesCylinder<dim> stokes(radius, half_length, n_refines, nu, tau,
-                               elementOrder, write_vtk, rhs, boundary,
-                               analytical_velocity, analytical_pressure,
-                               sphere_radius, sphere_x_coord);
-    Error error = stokes.run(n_steps);
-    std::cout << "Mesh size: " << error.mesh_size << std::endl;
-    std::cout << "|| u - u_h ||_L2 = " << error.l2_error_u << std::endl;
-    std::cout << "|| u - u_h ||_H1 = " << error.h1_error_u << std::endl;
-    std::cout << "| u - u_h |_H1 = " << error.h1_semi_u << std::endl;
-    std::cout << "|| p - p_h ||_L2 = " << error.l2_error_p << std::endl;
-    std::cout << "|| p - p_h ||_H1 = " << error.h1_error_p << std::endl;
-    std::cout << "| p - p_h |_H1 = " << error.h1_semi_p << std::endl;
+    Sphere<dim> domain(sphere_radius, sphere_x_coord, 0);
+
+    // Implicit Euler is BDF-1, with Dirichlet boundary conditions on the
+    // whole outer boundary.
+    StokesEqn<dim> stokes(nu, tau, radius, half_length, n_refines,
+                          elementOrder, write_vtk, rhs, boundary,
+                          analytical_velocity, analytical_pressure, domain);
+    ErrorBase *err = stokes.run_time(1, n_steps);
+    auto *error = dynamic_cast<ErrorFlow *>(err);
+    std::cout << "Mesh size: " << error->h << std::endl;
+    std::cout << "|| u - u_h ||_L2 = " << error->l2_error_u << std::endl;
+    std::cout << "|| u - u_h ||_H1 = " << error->h1_error_u << std::endl;
+    std::cout << "| u - u_h |_H1 = " << error->h1_semi_u << std::endl;
+    std::cout << "|| p - p_h ||_L2 = " << error->l2_error_p << std::endl;
+    std::cout << "|| p - p_h ||_H1 = " << error->h1_error_p << std::endl;
+    std::cout << "| p - p_h |_H1 = " << error->h1_semi_p << std::endl;
 }
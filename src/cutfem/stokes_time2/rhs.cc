@@ -32,6 +32,22 @@ namespace examples::cut::StokesEquation {
         return val;
     }
 
+    template<int dim>
+    void RightHandSide<dim>::
+    value_list(const std::vector<Point<dim>> &points,
+               std::vector<Tensor<1, dim>> &values) const {
+        const double amplitude =
+                pi * exp(-4 * pi * pi * nu * this->get_time()) / 2;
+        utils::evaluate_in_batches(
+                points, values,
+                [amplitude](const Point<dim, VectorizedArray<double>> &p) {
+                    Tensor<1, dim, VectorizedArray<double>> val;
+                    val[0] = amplitude * std::sin(2 * pi * p[0]);
+                    val[1] = amplitude * std::sin(2 * pi * p[1]);
+                    return val;
+                });
+    }
+
 
     template<int dim>
     BoundaryValues<dim>::BoundaryValues(const double nu)
@@ -50,6 +66,23 @@ namespace examples::cut::StokesEquation {
         return val;
     }
 
+    template<int dim>
+    void BoundaryValues<dim>::
+    value_list(const std::vector<Point<dim>> &points,
+               std::vector<Tensor<1, dim>> &values) const {
+        const double decay = exp(-2 * pi * pi * nu * this->get_time());
+        utils::evaluate_in_batches(
+                points, values,
+                [decay](const Point<dim, VectorizedArray<double>> &p) {
+                    const VectorizedArray<double> x = pi * p[0];
+                    const VectorizedArray<double> y = pi * p[1];
+                    Tensor<1, dim, VectorizedArray<double>> val;
+                    val[0] = -decay * std::sin(y) * std::cos(x);
+                    val[1] = decay * std::sin(x) * std::cos(y);
+                    return val;
+                });
+    }
+
 
     template<int dim>
     AnalyticalVelocity<dim>::AnalyticalVelocity(const double nu)
@@ -142,6 +175,18 @@ namespace examples::cut::StokesEquation {
         return -sqrt(pow(x - x0, 2) + pow(y - y0, 2)) + sphere_radius;
     }
 
+    template<int dim>
+    VectorizedArray<double> MovingDomain<dim>::
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p) const {
+        const double t = this->get_time();
+        const double x0 = 0.9 * (half_length - sphere_radius) *
+                          (2 * t / 0.05 - 1);
+        const double y0 = 0.9 * (radius - sphere_radius) * (2 * t / 0.05 - 1);
+        const VectorizedArray<double> x = p[0] - x0;
+        const VectorizedArray<double> y = p[1] - y0;
+        return sphere_radius - std::sqrt(x * x + y * y);
+    }
+
     template<int dim>
     Tensor<1, dim> MovingDomain<dim>::
     get_velocity() {
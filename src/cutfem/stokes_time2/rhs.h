@@ -23,6 +23,13 @@ namespace examples::cut::StokesEquation {
         Tensor<1, dim>
         value(const Point<dim> &p) const override;
 
+        /**
+         * Evaluate the right hand side in all the points, in SIMD batches.
+         */
+        void
+        value_list(const std::vector<Point<dim>> &points,
+                   std::vector<Tensor<1, dim>> &values) const override;
+
         const double nu;
     };
 
@@ -35,6 +42,13 @@ namespace examples::cut::StokesEquation {
         Tensor<1, dim>
         value(const Point<dim> &p) const override;
 
+        /**
+         * Evaluate the boundary values in all the points, in SIMD batches.
+         */
+        void
+        value_list(const std::vector<Point<dim>> &points,
+                   std::vector<Tensor<1, dim>> &values) const override;
+
         const double nu;
     };
 
@@ -80,6 +94,9 @@ namespace examples::cut::StokesEquation {
         double
         value(const Point<dim> &p, const unsigned int component) const override;
 
+        VectorizedArray<double>
+        vectorized_value(const Point<dim, VectorizedArray<double>> &p) const override;
+
         Tensor<1, dim>
         get_velocity() override;
 
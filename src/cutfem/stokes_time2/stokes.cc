@@ -60,7 +60,13 @@ namespace examples::cut::StokesEquation {
                                levelset_func, analytic_vel, analytic_pressure,
                                stabilized, stationary, compute_error),
               nu(nu), radius(radius), half_length(half_length),
-              do_nothing_id(do_nothing_id) {
+              do_nothing_id(do_nothing_id),
+              surface_output("interface-d" + std::to_string(dim)
+                             + "o" + std::to_string(element_order)
+                             + "r" + std::to_string(n_refines),
+                             this->mpi_communicator,
+                             {"pressure", "traction", "weight"},
+                             {1, dim, 1}) {
         this->tau = tau;
 
         // Use Dirichlet boundary conditions everywhere, this is done by
@@ -120,9 +126,9 @@ namespace examples::cut::StokesEquation {
     assemble_matrix() {
         this->pcout << "Assembling: Stokes" << std::endl;
 
-        // Object deciding what faces should be stabilized.
-        std::shared_ptr<Selector<dim>> face_selector(
-                new Selector<dim>(this->cut_mesh_classifier));
+        // The cached flags deciding what faces should be stabilized.
+        const std::shared_ptr<StabilizedFaces<dim>> &face_selector =
+                this->stabilized_faces;
 
         // Use a helper object to compute the stabilisation for both the velocity
         // and the pressure component.
@@ -504,6 +510,101 @@ namespace examples::cut::StokesEquation {
     }
 
 
+    template<int dim>
+    void StokesEqn<dim>::
+    set_interface_output(const bool only_interface) {
+        interface_output = only_interface;
+    }
+
+
+    template<int dim>
+    void StokesEqn<dim>::
+    output_results(std::shared_ptr<hp::DoFHandler<dim>> &dof_handler,
+                   LA::MPI::Vector &solution,
+                   const int time_step,
+                   const bool minimal_output) const {
+        if (interface_output) {
+            output_interface(dof_handler, solution, time_step);
+        } else {
+            FlowProblem<dim>::output_results(dof_handler, solution,
+                                             time_step, minimal_output);
+        }
+    }
+
+
+    template<int dim>
+    void StokesEqn<dim>::
+    output_interface(std::shared_ptr<hp::DoFHandler<dim>> &dof_handler,
+                     LA::MPI::Vector &solution,
+                     const int time_step) const {
+        this->pcout << "Output interface" << std::endl;
+
+        NonMatching::RegionUpdateFlags region_update_flags;
+        region_update_flags.surface = update_values | update_gradients |
+                                      update_JxW_values |
+                                      update_quadrature_points |
+                                      update_normal_vectors;
+
+        NonMatching::FEValues<dim> cut_fe_values(this->mapping_collection,
+                                                 this->fe_collection,
+                                                 this->q_collection,
+                                                 this->q_collection1D,
+                                                 region_update_flags,
+                                                 this->cut_mesh_classifier,
+                                                 this->levelset_dof_handler,
+                                                 this->levelset);
+
+        const FEValuesExtractors::Vector v(0);
+        const FEValuesExtractors::Scalar p(dim);
+
+        std::vector<Tensor<2, dim>> u_gradients;
+        std::vector<double> p_values;
+        std::vector<Point<dim>> points;
+        std::vector<Tensor<1, dim>> normals;
+        std::vector<std::vector<double>> values;
+        for (const auto &cell : dof_handler->active_cell_iterators()) {
+            if (!cell->is_locally_owned()) {
+                continue;
+            }
+            cut_fe_values.reinit(cell);
+            const std_cxx17::optional<FEImmersedSurfaceValues<dim>> &
+                    fe_values_surface = cut_fe_values.get_surface_fe_values();
+            if (!fe_values_surface) {
+                continue;
+            }
+            const unsigned int n_q_points =
+                    fe_values_surface->n_quadrature_points;
+            u_gradients.resize(n_q_points);
+            p_values.resize(n_q_points);
+            (*fe_values_surface)[v].get_function_gradients(solution,
+                                                           u_gradients);
+            (*fe_values_surface)[p].get_function_values(solution, p_values);
+
+            points.resize(n_q_points);
+            normals.resize(n_q_points);
+            values.resize(n_q_points);
+            for (unsigned int q = 0; q < n_q_points; ++q) {
+                // The normal of the surface values points out of the fluid.
+                const Tensor<1, dim> normal =
+                        -fe_values_surface->normal_vector(q);
+                const Tensor<1, dim> traction =
+                        nu * u_gradients[q] * normal - p_values[q] * normal;
+                points[q] = fe_values_surface->quadrature_point(q);
+                normals[q] = normal;
+                values[q].clear();
+                values[q].push_back(p_values[q]);
+                for (unsigned int d = 0; d < dim; ++d) {
+                    values[q].push_back(traction[d]);
+                }
+                values[q].push_back(fe_values_surface->JxW(q));
+            }
+            surface_output.add_cell(points, normals, values);
+        }
+        surface_output.write(time_step,
+                             this->start_time + time_step * this->tau);
+    }
+
+
     template
     class StokesEqn<2>;
 
@@ -31,6 +31,7 @@
 #include <vector>
 
 #include "../utils/flow_problem.h"
+#include "../utils/surface_output.h"
 #include "rhs.h"
 
 
@@ -70,6 +71,15 @@ namespace examples::cut::StokesEquation {
         void
         write_error_to_file(ErrorBase *error, std::ofstream &file);
 
+        /**
+         * Only output the interface, instead of the solution and the level
+         * set on the whole mesh, see output_interface(). This reduces the
+         * output by orders of magnitude for long runs, when only the
+         * geometry of the interface and the forces on it are needed.
+         */
+        void
+        set_interface_output(bool only_interface);
+
     protected:
         void
         set_function_times(double time) override;
@@ -101,6 +111,25 @@ namespace examples::cut::StokesEquation {
                 const std::vector<types::global_dof_index> &loc2glb) override;
 
 
+        void
+        output_results(std::shared_ptr<hp::DoFHandler<dim>> &dof_handler,
+                       LA::MPI::Vector &solution,
+                       int time_step,
+                       bool minimal_output = false) const override;
+
+        /**
+         * Write the points of the surface quadrature of the cut cells, with
+         * the pressure p, the traction σn = ν∇u n - pn, and the quadrature
+         * weights, such that the forces on the interface can be integrated in
+         * post processing. The normal n points out of the bubble, into the
+         * fluid domain, as in the computation of the surface forces. See
+         * utils::SurfaceOutput.
+         */
+        void
+        output_interface(std::shared_ptr<hp::DoFHandler<dim>> &dof_handler,
+                         LA::MPI::Vector &solution,
+                         int time_step) const;
+
         const double nu;
 
         const double radius;
@@ -111,6 +140,10 @@ namespace examples::cut::StokesEquation {
         // Scaling constants for the stabilizations.
         double velocity_stab_scaling = 0;
         double pressure_stab_scaling = 0;
+
+        // Output of the interface only, see set_interface_output().
+        bool interface_output = false;
+        mutable utils::SurfaceOutput<dim> surface_output;
     };
 
 } // namespace examples::cut::StokesEquation
@@ -0,0 +1,146 @@
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "anderson_acceleration.h"
+#include "cutfem_problem.h"
+
+
+using namespace dealii;
+
+namespace utils {
+
+    template<typename VectorType>
+    AndersonAcceleration<VectorType>::
+    AndersonAcceleration(const unsigned int depth, const double relaxation)
+            : depth(depth) {
+        set_relaxation(relaxation);
+    }
+
+
+    template<typename VectorType>
+    void AndersonAcceleration<VectorType>::
+    reset() {
+        has_previous = false;
+        residual_differences.clear();
+        image_differences.clear();
+        residual_history.clear();
+    }
+
+
+    template<typename VectorType>
+    void AndersonAcceleration<VectorType>::
+    set_depth(const unsigned int new_depth) {
+        depth = new_depth;
+        while (residual_differences.size() > depth) {
+            residual_differences.pop_front();
+            image_differences.pop_front();
+        }
+    }
+
+
+    template<typename VectorType>
+    void AndersonAcceleration<VectorType>::
+    set_relaxation(const double new_relaxation) {
+        if (new_relaxation <= 0 || new_relaxation > 1) {
+            throw std::invalid_argument(
+                    "The relaxation parameter has to be in (0, 1], not "
+                    + std::to_string(new_relaxation) + ".");
+        }
+        relaxation = new_relaxation;
+    }
+
+
+    template<typename VectorType>
+    unsigned int AndersonAcceleration<VectorType>::
+    get_depth() const {
+        return depth;
+    }
+
+
+    template<typename VectorType>
+    double AndersonAcceleration<VectorType>::
+    compute_next_iterate(const VectorType &iterate,
+                         const VectorType &image,
+                         VectorType &next_iterate) {
+        // The fixed point residual f_k = g(x_k) - x_k.
+        VectorType residual(image);
+        residual -= iterate;
+        const double residual_norm = residual.l2_norm();
+        residual_history.push_back(residual_norm);
+
+        // Update the differences dF and dG with the new residual and image.
+        if (has_previous && depth > 0) {
+            residual_differences.push_back(residual);
+            residual_differences.back() -= previous_residual;
+            image_differences.push_back(image);
+            image_differences.back() -= previous_image;
+            if (residual_differences.size() > depth) {
+                residual_differences.pop_front();
+                image_differences.pop_front();
+            }
+        }
+        previous_residual.reinit(residual, true);
+        previous_residual = residual;
+        previous_image.reinit(image, true);
+        previous_image = image;
+        has_previous = true;
+
+        const unsigned int m = residual_differences.size();
+
+        // Solve the normal equations dF^T dF y = dF^T f_k of the least
+        // squares problem. The system is only of size m x m, so it is solved
+        // directly on each process.
+        Vector<double> coefficients(m);
+        if (m > 0) {
+            FullMatrix<double> normal_matrix(m, m);
+            Vector<double> normal_rhs(m);
+            double max_diagonal = 0;
+            for (unsigned int i = 0; i < m; ++i) {
+                for (unsigned int j = 0; j <= i; ++j) {
+                    normal_matrix(i, j) =
+                            residual_differences[i] * residual_differences[j];
+                    normal_matrix(j, i) = normal_matrix(i, j);
+                }
+                normal_rhs(i) = residual_differences[i] * residual;
+                max_diagonal = std::max(max_diagonal, normal_matrix(i, i));
+            }
+            // Regularize, since the differences may be close to linearly
+            // dependent when the iteration is close to convergence.
+            for (unsigned int i = 0; i < m; ++i) {
+                normal_matrix(i, i) += regularization * max_diagonal;
+            }
+            normal_matrix.gauss_jordan();
+            normal_matrix.vmult(coefficients, normal_rhs);
+        }
+
+        // x_{k+1} = g(x_k) - dG y - (1 - β)(f_k - dF y)
+        next_iterate.reinit(image, true);
+        next_iterate = image;
+        for (unsigned int i = 0; i < m; ++i) {
+            next_iterate.add(-coefficients(i), image_differences[i]);
+            residual.add(-coefficients(i), residual_differences[i]);
+        }
+        if (relaxation != 1) {
+            next_iterate.add(relaxation - 1, residual);
+        }
+        return residual_norm;
+    }
+
+
+    template<typename VectorType>
+    const std::vector<double> &AndersonAcceleration<VectorType>::
+    get_residual_history() const {
+        return residual_history;
+    }
+
+
+    template
+    class AndersonAcceleration<Vector<double>>;
+
+    template
+    class AndersonAcceleration<LA::MPI::Vector>;
+
+} // namespace utils
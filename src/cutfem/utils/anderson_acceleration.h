@@ -0,0 +1,98 @@
+#ifndef MICROBUBBLE_UTILS_ANDERSON_ACCELERATION_H
+#define MICROBUBBLE_UTILS_ANDERSON_ACCELERATION_H
+
+#include <deque>
+#include <vector>
+
+
+namespace utils {
+
+    /**
+     * Anderson acceleration of a fixed point iteration x = g(x).
+     *
+     * Given the current iterate x_k and its image g(x_k), the next iterate is
+     * computed from the last m differences of the fixed point residuals
+     * f_i = g(x_i) - x_i, instead of just using x_{k+1} = g(x_k). The
+     * coefficients y are found by solving the least squares problem
+     *   min || f_k - dF y ||,
+     * where the columns of dF are f_{i+1} - f_i. The next iterate is then
+     *   x_{k+1} = g(x_k) - dG y - (1 - β)(f_k - dF y),
+     * where the columns of dG are g(x_{i+1}) - g(x_i) and β is the
+     * relaxation parameter. With depth m = 0 this is a relaxed fixed point
+     * iteration, and m = 1 gives an Aitken-like secant update.
+     *
+     * The class is independent of the problem being solved, so it can be
+     * used for the Picard iteration of Navier-Stokes, as well as for e.g. a
+     * partitioned fluid-structure coupling loop. The vectors passed to
+     * compute_next_iterate() must not have ghost elements, and must have the
+     * same layout throughout the iteration. Call reset() before starting a
+     * new iteration.
+     *
+     * @tparam VectorType
+     */
+    template<typename VectorType>
+    class AndersonAcceleration {
+    public:
+        /**
+         * @param depth: the number of previous residuals used, m.
+         * @param relaxation: the relaxation parameter β in (0, 1].
+         */
+        AndersonAcceleration(unsigned int depth = 5,
+                             double relaxation = 1);
+
+        /**
+         * Remove all the stored differences and residuals.
+         */
+        void
+        reset();
+
+        void
+        set_depth(unsigned int depth);
+
+        void
+        set_relaxation(double relaxation);
+
+        unsigned int
+        get_depth() const;
+
+        /**
+         * Compute the next iterate x_{k+1}, from the current iterate
+         * x_k and its image g(x_k).
+         *
+         * @return the l2-norm of the fixed point residual g(x_k) - x_k.
+         */
+        double
+        compute_next_iterate(const VectorType &iterate,
+                             const VectorType &image,
+                             VectorType &next_iterate);
+
+        /**
+         * Return the l2-norms of the fixed point residuals of all the calls
+         * to compute_next_iterate() since the last reset().
+         */
+        const std::vector<double> &
+        get_residual_history() const;
+
+    private:
+        unsigned int depth;
+        double relaxation;
+
+        // Regularization added to the diagonal of the normal equations of
+        // the least squares problem, relative to the largest diagonal entry.
+        const double regularization = 1e-12;
+
+        // The residual f and image g from the previous call.
+        VectorType previous_residual;
+        VectorType previous_image;
+        bool has_previous = false;
+
+        // The columns of dF and dG, the newest difference at the back.
+        std::deque<VectorType> residual_differences;
+        std::deque<VectorType> image_differences;
+
+        std::vector<double> residual_history;
+    };
+
+} // namespace utils
+
+#endif //MICROBUBBLE_UTILS_ANDERSON_ACCELERATION_H
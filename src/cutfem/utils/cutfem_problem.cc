@@ -10,6 +10,7 @@
 
 #include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
 #include <deal.II/lac/solver_control.h>
 #include <deal.II/lac/sparse_direct.h>
 
@@ -18,6 +19,11 @@
 #include <deal.II/numerics/data_out_dof_data.h>
 #include <deal.II/numerics/vector_tools.h>
 
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <type_traits>
+
 #include "utils.h"
 #include "cutfem_problem.h"
 
@@ -37,6 +43,43 @@ namespace utils::problems {
         return sqrt(get_velocity().norm_square());
     }
 
+    template<int dim>
+    Tensor<1, dim> LevelSet<dim>::
+    get_local_velocity(const Point<dim> &point) {
+        (void) point;
+        return get_velocity();
+    }
+
+    template<int dim>
+    VectorizedArray<double> LevelSet<dim>::
+    vectorized_value(const Point<dim, VectorizedArray<double>> &points) const {
+        VectorizedArray<double> values;
+        Point<dim> point;
+        for (unsigned int lane = 0; lane < VectorizedArray<double>::size(); ++lane) {
+            for (unsigned int d = 0; d < dim; ++d) {
+                point[d] = points[d][lane];
+            }
+            values[lane] = this->value(point);
+        }
+        return values;
+    }
+
+    template<int dim>
+    void LevelSet<dim>::
+    value_list(const std::vector<Point<dim>> &points,
+               std::vector<double> &values,
+               const unsigned int component) const {
+        (void) component;
+        // The output vector is expected to have the right size already, as
+        // in Function::value_list.
+        assert(values.size() == points.size());
+        evaluate_in_batches(
+                points, values,
+                [this](const Point<dim, VectorizedArray<double>> &batch) {
+                    return vectorized_value(batch);
+                });
+    }
+
 
     template<int dim>
     CutFEMProblem<dim>::
@@ -46,8 +89,9 @@ namespace utils::problems {
                   LevelSet<dim> &levelset_func,
                   const bool stabilized,
                   const bool stationary,
-                  const bool compute_error)
-            : mpi_communicator(MPI_COMM_WORLD), 
+                  const bool compute_error,
+                  const MPI_Comm &mpi_communicator)
+            : mpi_communicator(mpi_communicator),
               triangulation(mpi_communicator,
                             typename Triangulation<dim>::MeshSmoothing(
                               Triangulation<dim>::smoothing_on_refinement |
@@ -57,8 +101,11 @@ namespace utils::problems {
               fe_levelset(element_order),
               levelset_dof_handler(triangulation),
               cut_mesh_classifier(levelset_dof_handler, levelset),
+              stabilized_faces(new StabilizedFaces<dim>(cut_mesh_classifier)),
               stabilized(stabilized), stationary(stationary),
               do_compute_error(compute_error), 
+              fixed_point_acceleration(0, 1),
+              vector_pool(mpi_communicator),
               pcout(std::cout, 
                     (Utilities::MPI::this_mpi_process(mpi_communicator) == 0)), 
               computing_timer(mpi_communicator, 
@@ -87,6 +134,7 @@ namespace utils::problems {
 #endif
               << " on " << Utilities::MPI::n_mpi_processes(mpi_communicator)
               << " MPI rank(s)." << std::endl;
+        in_time_loop = false;
 
         make_grid(triangulation);
         std::cout << "  n_cells = " << triangulation.n_cells() << std::endl;
@@ -109,8 +157,7 @@ namespace utils::problems {
         set_bdf_coefficients(1);
         set_extrapolation_coefficients(1);
         
-        solutions.emplace_front(locally_owned_dofs, locally_relevant_dofs,
-                                mpi_communicator);
+        push_new_solution();
 
         initialize_matrices();
         pre_matrix_assembly();
@@ -133,6 +180,8 @@ namespace utils::problems {
             TimerOutput::Scope t(computing_timer, "compute error");
             error = compute_error(dof_handlers.front(), solutions.front());
         }
+        timings = computing_timer.get_summary_data(
+                TimerOutput::total_wall_time);
         computing_timer.print_summary();
         computing_timer.reset();
         return error;
@@ -141,7 +190,7 @@ namespace utils::problems {
 
     template<int dim>
     ErrorBase *CutFEMProblem<dim>::
-    run_step_non_linear(double tol) {
+    run_step_non_linear(double tol, const unsigned int max_iterations) {
         pcout << "Solve equation: non-linear." << std::endl;
         pcout << "---------------------------\n" << std::endl;
 
@@ -169,28 +218,32 @@ namespace utils::problems {
         double prev_error;
         double this_error = 1; // Set to 1 to enforce at least two steps.
         ErrorBase *error;
-        double error_diff = 2 * tol;
-        int k = 0;
+        double error_diff;
+        double residual_norm;
+        bool converged = false;
+        unsigned int k = 0;
 
-        solutions.emplace_front(locally_owned_dofs, locally_relevant_dofs, 
-                                mpi_communicator);
+        // Vectors without ghost elements, used for the acceleration.
+        LA::MPI::Vector iterate(locally_owned_dofs, mpi_communicator);
+        LA::MPI::Vector image(locally_owned_dofs, mpi_communicator);
+        LA::MPI::Vector next_iterate(locally_owned_dofs, mpi_communicator);
+        fixed_point_acceleration.reset();
 
-        while (error_diff > tol) {
+        push_new_solution();
+
+        while (!converged && k < max_iterations) {
             k++;
             pcout << "\nFixed point iteration: step " << k << std::endl;
             pcout << "-----------------------------------" << std::endl;
 
-            solutions.emplace_front(locally_owned_dofs, locally_relevant_dofs, 
-                                    mpi_communicator);
+            push_new_solution();
             if (k == 1) {
                 initialize_matrices();
                 pre_matrix_assembly();
                 assemble_matrix();
             }
             if (!stationary_stiffness_matrix) {
-                // timedep_stiffness_matrix.reinit(sparsity_pattern);
-                // TODO fix
-                assert(false);
+                timedep_stiffness_matrix = 0;
                 assemble_timedep_matrix();
             }
 
@@ -198,20 +251,40 @@ namespace utils::problems {
             assemble_rhs(0);
 
             solve();
+
+            // Now solutions[1] holds the iterate u_k, and solutions.front()
+            // holds its image g(u_k). Replace the image by the next
+            // (possibly accelerated) iterate.
+            iterate = solutions[1];
+            image = solutions.front();
+            residual_norm = fixed_point_acceleration.compute_next_iterate(
+                    iterate, image, next_iterate);
+            solutions.front() = next_iterate;
+            pcout << "  Fixed point residual = " << residual_norm << std::endl;
+
             post_processing(k);
 
-            error = compute_error(dof_handlers.front(), solutions.front());
-            prev_error = this_error;
-            this_error = error->repr_error();
-            error->output();
-            error_diff = abs(this_error - prev_error);
-            pcout << "  Error diff = " << error_diff << std::endl;
+            if (do_compute_error) {
+                error = compute_error(dof_handlers.front(), solutions.front());
+                prev_error = this_error;
+                this_error = error->repr_error();
+                error->output();
+                error_diff = abs(this_error - prev_error);
+                pcout << "  Error diff = " << error_diff << std::endl;
+                converged = error_diff < tol;
+            } else {
+                converged = residual_norm < tol;
+            }
 
             if (write_output) {
                 output_results(dof_handlers.front(), solutions.front(),
                                k, k > 1);
             }
-            solutions.pop_back();
+            pop_oldest_solution();
+        }
+        if (!converged) {
+            pcout << "# NB: the fixed point iteration did not converge in "
+                  << max_iterations << " iterations." << std::endl;
         }
         post_processing(k + 1);
 
@@ -223,6 +296,274 @@ namespace utils::problems {
     }
 
 
+    template<int dim>
+    void CutFEMProblem<dim>::
+    set_anderson_acceleration(const unsigned int depth,
+                              const double relaxation) {
+        fixed_point_acceleration.set_depth(depth);
+        fixed_point_acceleration.set_relaxation(relaxation);
+    }
+
+
+    template<int dim>
+    ErrorBase *CutFEMProblem<dim>::
+    run_step_newton(const double tol, const unsigned int max_iterations) {
+        pcout << "Solve equation: non-linear (Newton)." << std::endl;
+        pcout << "------------------------------------\n" << std::endl;
+
+        if (!stationary) {
+            throw std::logic_error(
+                    "run_step_newton is only implemented for stationary "
+                    "problems.");
+        }
+
+        make_grid(triangulation);
+        std::cout << "  n_cells = " << triangulation.n_cells() << std::endl;
+        set_grid_size();
+        setup_quadrature();
+        set_function_times(0);
+        setup_level_set();
+        cut_mesh_classifier.reclassify();
+        dof_handlers.emplace_front(new hp::DoFHandler<dim>(triangulation));
+        setup_fe_collection();
+        distribute_dofs(dof_handlers.front());
+
+        locally_owned_dofs = dof_handlers.front()->locally_owned_dofs();
+        DoFTools::extract_locally_relevant_dofs(*dof_handlers.front(),
+                                                locally_relevant_dofs);
+
+        set_bdf_coefficients(1);
+        set_extrapolation_coefficients(1);
+
+        // Only the current iterate is needed, the non-linear terms and their
+        // Jacobian are assembled using solutions.front().
+        push_new_solution();
+
+        // The Jacobian is assembled into timedep_stiffness_matrix, so make
+        // sure it is initialized.
+        stationary_stiffness_matrix = false;
+        initialize_matrices();
+        pre_matrix_assembly();
+        {
+            TimerOutput::Scope t(computing_timer, "assembly");
+            assemble_matrix();
+            assemble_rhs(0);
+        }
+
+        // Use the solution of the linear problem Au = f as the initial guess.
+        LA::MPI::Vector u(locally_owned_dofs, mpi_communicator);
+        {
+            TimerOutput::Scope t(computing_timer, "solve");
+            solve_linear_system(stiffness_matrix, rhs, u);
+        }
+
+        LA::MPI::Vector residual(locally_owned_dofs, mpi_communicator);
+        LA::MPI::Vector newton_update(locally_owned_dofs, mpi_communicator);
+        LA::MPI::Vector trial(locally_owned_dofs, mpi_communicator);
+        double residual_norm = compute_newton_residual(u, residual);
+        pcout << "  Initial residual = " << residual_norm << std::endl;
+
+        // Parameters for the backtracking line search: the step length is
+        // halved until the residual is sufficiently decreased.
+        const double sufficient_decrease = 1e-4;
+        const double min_step_length = 1.0 / 1024;
+
+        unsigned int k = 0;
+        while (residual_norm > tol && k < max_iterations) {
+            k++;
+            pcout << "\nNewton iteration: step " << k << std::endl;
+            pcout << "-----------------------------------" << std::endl;
+
+            // Assemble the Jacobian A + J(u), linearized around the current
+            // iterate, and solve (A + J(u))du = -R(u).
+            {
+                TimerOutput::Scope t(computing_timer, "assembly");
+                timedep_stiffness_matrix = 0;
+                assemble_newton_jacobian();
+                timedep_stiffness_matrix.add(1, stiffness_matrix);
+            }
+            residual *= -1;
+            {
+                TimerOutput::Scope t(computing_timer, "solve");
+                solve_linear_system(timedep_stiffness_matrix, residual,
+                                    newton_update);
+            }
+
+            double step_length = 1;
+            double trial_residual_norm;
+            while (true) {
+                trial = u;
+                trial.add(step_length, newton_update);
+                trial_residual_norm = compute_newton_residual(trial, residual);
+                if (trial_residual_norm <
+                    (1 - sufficient_decrease * step_length) * residual_norm ||
+                    step_length <= min_step_length) {
+                    break;
+                }
+                step_length /= 2;
+            }
+            u = trial;
+            residual_norm = trial_residual_norm;
+
+            pcout << "  Step length = " << step_length
+                  << ", residual = " << residual_norm << std::endl;
+
+            post_processing(k);
+            if (write_output) {
+                output_results(dof_handlers.front(), solutions.front(),
+                               k, k > 1);
+            }
+        }
+        if (residual_norm > tol) {
+            pcout << "# NB: Newton's method did not converge in "
+                  << max_iterations << " iterations, residual = "
+                  << residual_norm << std::endl;
+        }
+        // The last residual computation set solutions.front() = u.
+        post_processing(k + 1);
+
+        timings = computing_timer.get_summary_data(
+                TimerOutput::total_wall_time);
+        computing_timer.print_summary();
+        computing_timer.reset();
+
+        if (do_compute_error) {
+            return compute_error(dof_handlers.front(), solutions.front());
+        } else {
+            return nullptr;
+        }
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    set_bdf_terms_by_mass_matrix(const bool use_mass_matrix) {
+        bdf_terms_by_mass_matrix = use_mass_matrix;
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    set_extend_previous_solutions(const bool extend) {
+        extend_previous_solutions = extend;
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    set_local_active_band(const bool local_band) {
+        local_active_band = local_band;
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    set_linear_solver(const LinearSolver solver, const double tolerance) {
+        linear_solver = solver;
+        linear_solver_tolerance = tolerance;
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    set_preconditioner_reuse(const bool reuse, const double rebuild_factor) {
+        reuse_preconditioner = reuse;
+        preconditioner_rebuild_factor = rebuild_factor;
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    set_refinement_parameters(const double tolerance,
+                              const unsigned int max_steps) {
+        low_rank_tolerance = tolerance;
+        max_refinement_steps = max_steps;
+    }
+
+
+    template<int dim>
+    const std::vector<double> &CutFEMProblem<dim>::
+    get_refinement_residual_history() const {
+        return refinement_residuals;
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    set_snapshot_collector(ReducedBasis<LA::MPI::Vector> *collector) {
+        snapshot_collector = collector;
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    set_reduced_basis(const ReducedBasis<LA::MPI::Vector> *basis) {
+        reduced_basis = basis;
+    }
+
+
+    template<int dim>
+    double CutFEMProblem<dim>::
+    get_reduced_basis_estimate() const {
+        return reduced_basis_estimate;
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    set_krylov_recycling(const bool recycle,
+                         const unsigned int n_deflation_vectors,
+                         const unsigned int n_recycled_directions) {
+        krylov_recycling = recycle;
+        deflated_cg.clear();
+        deflated_cg.set_subspace_size(n_deflation_vectors,
+                                      n_recycled_directions);
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    set_multigrid(const LevelProblemFactory &factory,
+                  const unsigned int coarse_refines,
+                  const unsigned int smoothing_steps,
+                  const double damping) {
+        level_problem_factory = factory;
+        multigrid_coarse_refines = coarse_refines;
+        multigrid_smoothing_steps = smoothing_steps;
+        multigrid_damping = damping;
+        multigrid_preconditioner.reset();
+        multigrid_levels.clear();
+    }
+
+
+    template<int dim>
+    unsigned int CutFEMProblem<dim>::
+    get_linear_solver_iterations() const {
+        return linear_solver_iterations;
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    set_start_time(const double time) {
+        start_time = time;
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    set_error_file_suffix(const std::string &suffix) {
+        error_file_suffix = suffix;
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    set_project_first_steps(const bool project) {
+        project_first_steps = project;
+    }
+
+
     template<int dim>
     LA::MPI::Vector CutFEMProblem<dim>::
     get_solution() {
@@ -237,6 +578,24 @@ namespace utils::problems {
     }
 
 
+    template<int dim>
+    void CutFEMProblem<dim>::
+    set_output_format(const OutputFormat format, const bool float32,
+                      const unsigned int compression_level) {
+        output_format = format;
+        output_float32 = float32;
+        output_compression_level = compression_level;
+        hdf5_output.reset();
+    }
+
+
+    template<int dim>
+    const std::map<std::string, double> &CutFEMProblem<dim>::
+    get_timings() const {
+        return timings;
+    }
+
+
     template<int dim>
     ErrorBase *CutFEMProblem<dim>::
     run_time(unsigned int bdf_type, unsigned int steps,
@@ -254,7 +613,8 @@ namespace utils::problems {
               << " on " << Utilities::MPI::n_mpi_processes(mpi_communicator)
               << " MPI rank(s)." << std::endl;
 
-        assert(supplied_solutions.size() < bdf_type);
+        assert(supplied_solutions.size() <= bdf_type);
+        in_time_loop = true;
         // Clear the solutions and dof_handlers from possibly previous BDF
         // method runs performed by this object.
         solutions.clear();
@@ -268,7 +628,7 @@ namespace utils::problems {
             set_grid_size();
             setup_quadrature();
         }
-        set_function_times(0);
+        set_function_times(start_time);
         setup_level_set();
         cut_mesh_classifier.reclassify();
         setup_fe_collection();
@@ -298,7 +658,8 @@ namespace utils::problems {
 
         std::ofstream file("errors-time-d" + std::to_string(dim)
                            + "o" + std::to_string(element_order)
-                           + "r" + std::to_string(n_refines) + ".csv");
+                           + "r" + std::to_string(n_refines)
+                           + error_file_suffix + ".csv");
         write_time_header_to_file(file);
 
         // Write the errors for the first steps to file.
@@ -309,7 +670,7 @@ namespace utils::problems {
 
         double time;
         for (unsigned int k = bdf_type; k <= steps; ++k) {
-            time = k * tau;
+            time = start_time + k * tau;
             pcout << "\nTime Step = " << k
                       << ", tau = " << tau
                       << ", time = " << time << std::endl;
@@ -318,8 +679,7 @@ namespace utils::problems {
             set_function_times(time);
 
             // Create a new solution vector to contain the next solution.
-            solutions.emplace_front(locally_owned_dofs, locally_relevant_dofs, 
-                                    mpi_communicator);
+            push_new_solution();
 
             if (k == bdf_type) {
                 // Assemble the matrix after the new solution vector is created.
@@ -330,16 +690,20 @@ namespace utils::problems {
                 initialize_matrices();
                 pre_matrix_assembly();
                 assemble_matrix();
+                if (bdf_terms_by_mass_matrix) {
+                    assemble_mass_matrix();
+                }
             }
             if (!stationary_stiffness_matrix) {
-                // TODO fix
-                //  timedep_stiffness_matrix.reinit(sparsity_pattern);
-                assert(false);
+                timedep_stiffness_matrix = 0;
                 assemble_timedep_matrix();
             }
 
             rhs = 0;
             assemble_rhs(k);
+            if (bdf_terms_by_mass_matrix) {
+                add_bdf_terms_by_mass_matrix();
+            }
 
             solve();
             post_processing(k);
@@ -359,7 +723,7 @@ namespace utils::problems {
             }
 
             // Remove the oldest solution, since it is no longer needed.
-            solutions.pop_back();
+            pop_oldest_solution();
         }
 
         pcout << std::endl;
@@ -394,6 +758,14 @@ namespace utils::problems {
         pcout << "\nBDF-" << bdf_type << ", steps=" << steps << std::endl;
         pcout << "-------------------------" << std::endl;
         moving_domain = true;
+        if (linear_solver == LinearSolver::cg_gmg) {
+            throw std::invalid_argument(
+                    "LinearSolver::cg_gmg is not implemented for moving "
+                    "domains.");
+        }
+        // The face flags are only updated in the band swept by the interface
+        // during the run, so they are recomputed for the start position.
+        stabilized_faces->clear();
 
         // One dof_handler must be supplied for each supplied solution vector.
         assert(supplied_solutions.size() == supplied_dof_handlers.size());
@@ -401,6 +773,7 @@ namespace utils::problems {
         // method runs performed by this object.
         solutions.clear();
         dof_handlers.clear();
+        dof_histories.clear();
 
         // Don't make the triangulation if it was done by a previously run
         // of a BDF-method.
@@ -410,26 +783,14 @@ namespace utils::problems {
             set_grid_size();
             setup_quadrature();
         }
-        set_function_times(0);
+        set_function_times(start_time);
         setup_level_set();
         cut_mesh_classifier.reclassify(); // TODO any reason to keep this call outside the method above?
         setup_fe_collection();
 
-        // TODO compute the speed at each cell, to get a more precise calculation.
-
-        // Note that when using BDF-2 with BDF-1 for the u1 step, the acitve
-        // mesh for the BDF-1 method should be enlarged with a factor 2 with
-        // the use of the mesh_bound_multiplier, else the mesh will be two
-        // small when solving the step k=3 with BDF-2. This is naturally because
-        // of the constant bdf_type is used in the size_of_bound constant.
-        double buffer_constant = 1.5;
-        double size_of_bound = mesh_bound_multiplier * buffer_constant
-                               * (levelset_function->get_speed() * tau
-                                  * bdf_type + h);
-        pcout << " # size_of_bound = " << size_of_bound << std::endl;
-
         dof_handlers.emplace_front(new hp::DoFHandler<dim>());
-        distribute_dofs(dof_handlers.front(), size_of_bound);
+        distribute_dofs_in_band(dof_handlers.front(), bdf_type,
+                                mesh_bound_multiplier);
         
         // Get the dofs owned by this processor. This should probably be done 
         // only once during each run, to make sure they dont differ across time
@@ -451,7 +812,8 @@ namespace utils::problems {
 
         std::ofstream file("errors-time-d" + std::to_string(dim)
                            + "o" + std::to_string(element_order)
-                           + "r" + std::to_string(n_refines) + ".csv");
+                           + "r" + std::to_string(n_refines)
+                           + error_file_suffix + ".csv");
         write_time_header_to_file(file);
 
         pcout << "Interpolated / supplied solutions." << std::endl;
@@ -464,9 +826,16 @@ namespace utils::problems {
         // Check that we have created exactly one dof_handler per solution.
         assert(dof_handlers.size() == solutions.size());
 
+        // Keep only the cell to dof maps of the previous steps, and not the
+        // whole dof_handlers.
+        for (const auto &dof_handler : dof_handlers) {
+            dof_histories.emplace_back(*dof_handler);
+        }
+        dof_handlers.resize(1);
+
         double time;
         for (unsigned int k = bdf_type; k <= steps; ++k) {
-            time = k * tau;
+            time = start_time + k * tau;
             pcout << "\nTime Step = " << k
                       << ", tau = " << tau
                       << ", time = " << time << std::endl;
@@ -476,17 +845,13 @@ namespace utils::problems {
             cut_mesh_classifier.reclassify(); // TODO kalles denne i riktig rekkefølge?
 
             // Create a new solution vector to contain the next solution.
-            solutions.emplace_front(locally_owned_dofs, locally_relevant_dofs, 
-                                    mpi_communicator);
+            push_new_solution();
 
             // Redistribute the dofs after the level set was updated
-            // size_of_bound = buffer_constant * bdf_type * this->h;
-            size_of_bound = mesh_bound_multiplier * buffer_constant
-                            * (levelset_function->get_speed() * tau
-                               * bdf_type + h);
-            pcout << " # size_of_bound = " << size_of_bound << std::endl;
             dof_handlers.emplace_front(new hp::DoFHandler<dim>());
-            distribute_dofs(dof_handlers.front(), size_of_bound);
+            distribute_dofs_in_band(dof_handlers.front(), bdf_type,
+                                    mesh_bound_multiplier);
+            dof_histories.emplace_front(*dof_handlers.front());
 
             // Reinitialize the matrices and vectors after the number of dofs
             // was updated.
@@ -512,9 +877,11 @@ namespace utils::problems {
                                this->solutions.front(), k, false);
             }
 
-            // Remove the oldest solution and dof_handler, since they are
-            // no longer needed.
-            solutions.pop_back();
+            // Remove the oldest solution and its dofs, since they are no
+            // longer needed. The dof_handler of the previous step is also
+            // removed, since its dofs are kept in dof_histories.
+            pop_oldest_solution();
+            dof_histories.pop_back();
             dof_handlers.pop_back();
         }
 
@@ -543,6 +910,24 @@ namespace utils::problems {
     }
 
 
+    template<int dim>
+    void CutFEMProblem<dim>::
+    push_new_solution() {
+        // Only vectors with the current partitioning are reused.
+        vector_pool.reinit(locally_owned_dofs, locally_relevant_dofs);
+        solutions.emplace_front();
+        vector_pool.acquire_ghosted(solutions.front());
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    pop_oldest_solution() {
+        vector_pool.release(solutions.back());
+        solutions.pop_back();
+    }
+
+
     template<int dim>
     void CutFEMProblem<dim>::
     set_bdf_coefficients(unsigned int bdf_type) {
@@ -633,16 +1018,11 @@ namespace utils::problems {
             pcout << " - Interpolate step k = " << k << std::endl;
 
             // Interpolate it a the correct time.
-            set_function_times(k * tau);
+            set_function_times(start_time + k * tau);
 
             if (moving_domain && k > 0) {
                 // For moving domains we need a new dof_handler for each step,
                 // but the first one should already have been created.
-                double buffer_constant = 1.5;
-                // TODO take this calculation out of this function.
-                double size_of_bound = mesh_bound_multiplier * buffer_constant
-                                       * (levelset_function->get_speed() * tau
-                                          * bdf_type + h);
 
                 // TODO da jeg la til disse to linjene ble feilen regnet ut riktig
                 //  for supplied solution. Betyr dette at dof_handler ikke blir
@@ -650,11 +1030,11 @@ namespace utils::problems {
                 setup_level_set();
                 cut_mesh_classifier.reclassify();
                 dof_handlers.emplace_front(new hp::DoFHandler<dim>());
-                distribute_dofs(dof_handlers.front(), size_of_bound);
+                distribute_dofs_in_band(dof_handlers.front(), bdf_type,
+                                        mesh_bound_multiplier);
             }
             
-            solutions.emplace_front(locally_owned_dofs, locally_relevant_dofs,
-                                    mpi_communicator);
+            push_new_solution();
 
             interpolate_solution(dof_handlers.front(), k);
 
@@ -734,7 +1114,7 @@ namespace utils::problems {
                 }
 
                 // Overwrite the error too.
-                set_function_times(k * tau);
+                set_function_times(start_time + k * tau);
                 // If the domain is stationary, we only have one dof_handler.
                 // dof_index = moving_domain ? solution_index : 0;
                 errors[k] = compute_error(dof_handlers[dof_index],
@@ -827,6 +1207,20 @@ namespace utils::problems {
         pcout << "Distribute dofs" << std::endl;
         TimerOutput::Scope t(computing_timer, "distribute dofs");
         dof_handler->initialize(triangulation, fe_collection);
+
+        // Evaluate the level set in all the cell centers at once, so it can
+        // be done in SIMD batches.
+        std::vector<Point<dim>> centers;
+        centers.reserve(triangulation.n_locally_owned_active_cells());
+        for (const auto &cell : dof_handler->active_cell_iterators()) {
+            if (cell->is_locally_owned()) {
+                centers.push_back(cell->center());
+            }
+        }
+        std::vector<double> distances_from_zero_contour(centers.size());
+        levelset_function->value_list(centers, distances_from_zero_contour);
+
+        unsigned int center_index = 0;
         for (const auto &cell : dof_handler->active_cell_iterators()) {
             if (cell->is_locally_owned()) {
 
@@ -834,7 +1228,7 @@ namespace utils::problems {
                         cut_mesh_classifier.location_to_level_set(cell);
 
                 const double distance_from_zero_contour =
-                        levelset_function->value(cell->center());
+                        distances_from_zero_contour[center_index++];
 
                 if (LocationToLevelSet::inside == location ||
                     LocationToLevelSet::intersected == location ||
@@ -848,6 +1242,185 @@ namespace utils::problems {
             }
         }
         dof_handler->distribute_dofs(this->fe_collection);
+        preconditioner_outdated = true;
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    distribute_dofs_in_band(std::shared_ptr<hp::DoFHandler<dim>> &dof_handler,
+                            const unsigned int bdf_type,
+                            const double mesh_bound_multiplier) {
+        if (!local_active_band || extend_previous_solutions) {
+            // When the previous solutions are extended, the band does not
+            // depend on the speed of the domain.
+            const double size_of_bound = compute_size_of_bound(
+                    bdf_type, mesh_bound_multiplier);
+            pcout << " # size_of_bound = " << size_of_bound << std::endl;
+            distribute_dofs(dof_handler, size_of_bound);
+            return;
+        }
+
+        pcout << "Distribute dofs (local band)" << std::endl;
+        TimerOutput::Scope t(computing_timer, "distribute dofs");
+        dof_handler->initialize(triangulation, fe_collection);
+
+        // The normal in the cell center is computed from the gradient of the
+        // discrete level set, since the level set function is not required
+        // to implement gradient().
+        FEValues<dim> fe_values_levelset(mapping_collection[0],
+                                         fe_levelset,
+                                         QMidpoint<dim>(),
+                                         update_gradients |
+                                         update_quadrature_points);
+        std::vector<Tensor<1, dim>> levelset_gradients(1);
+        const double global_speed = levelset_function->get_speed();
+
+        double max_size_of_bound = 0;
+        for (const auto &cell : dof_handler->active_cell_iterators()) {
+            if (!cell->is_locally_owned()) {
+                continue;
+            }
+            const LocationToLevelSet location =
+                    cut_mesh_classifier.location_to_level_set(cell);
+            if (LocationToLevelSet::inside == location ||
+                LocationToLevelSet::intersected == location) {
+                cell->set_active_fe_index(0);
+                continue;
+            }
+
+            const typename DoFHandler<dim>::active_cell_iterator ls_cell(
+                    &triangulation, cell->level(), cell->index(),
+                    &levelset_dof_handler);
+            fe_values_levelset.reinit(ls_cell);
+            fe_values_levelset.get_function_gradients(levelset,
+                                                      levelset_gradients);
+            const Point<dim> &center = fe_values_levelset.quadrature_point(0);
+
+            // The gradient of the level set gives the outward normal of the
+            // domain {φ < 0}. Only the advancing side of the interface, where
+            // v·n > 0, moves towards the cell, so the band is not extended
+            // behind the domain.
+            double speed = global_speed;
+            const double gradient_norm = levelset_gradients[0].norm();
+            if (gradient_norm > 1e-12) {
+                const Tensor<1, dim> normal =
+                        levelset_gradients[0] / gradient_norm;
+                speed = std::max(
+                        0.0,
+                        levelset_function->get_local_velocity(center) * normal);
+            }
+            const double size_of_bound = compute_size_of_bound(
+                    bdf_type, mesh_bound_multiplier, speed);
+            max_size_of_bound = std::max(max_size_of_bound, size_of_bound);
+
+            const double distance_from_zero_contour =
+                    levelset_function->value(center);
+            if (distance_from_zero_contour <= size_of_bound) {
+                // 0 is fe
+                cell->set_active_fe_index(0);
+            } else {
+                // 1 is FE_nothing
+                cell->set_active_fe_index(1);
+            }
+        }
+        max_size_of_bound = Utilities::MPI::max(max_size_of_bound,
+                                                mpi_communicator);
+        pcout << " # max size_of_bound = " << max_size_of_bound << std::endl;
+        dof_handler->distribute_dofs(this->fe_collection);
+        preconditioner_outdated = true;
+    }
+
+
+    template<int dim>
+    double CutFEMProblem<dim>::
+    compute_size_of_bound(const unsigned int bdf_type,
+                          const double mesh_bound_multiplier) const {
+        return compute_size_of_bound(bdf_type, mesh_bound_multiplier,
+                                     levelset_function->get_speed());
+    }
+
+
+    template<int dim>
+    double CutFEMProblem<dim>::
+    compute_size_of_bound(const unsigned int bdf_type,
+                          const double mesh_bound_multiplier,
+                          const double speed) const {
+        if (extend_previous_solutions) {
+            // The previous solutions are extended onto the cells that are
+            // activated, so the safety factors below are not needed. The band
+            // must still cover the movement of the domain, else the cells in
+            // the domain can be too far from the previous active cells to
+            // find a cell to extend from.
+            return std::max(mesh_bound_multiplier * h,
+                            speed * tau * bdf_type + h);
+        }
+        // Note that when using BDF-2 with BDF-1 for the u1 step, the acitve
+        // mesh for the BDF-1 method should be enlarged with a factor 2 with
+        // the use of the mesh_bound_multiplier, else the mesh will be two
+        // small when solving the step k=3 with BDF-2. This is naturally because
+        // of the constant bdf_type is used in the size_of_bound constant.
+        const double buffer_constant = 1.5;
+        return mesh_bound_multiplier * buffer_constant
+               * (speed * tau * bdf_type + h);
+    }
+
+
+    template<int dim>
+    unsigned int CutFEMProblem<dim>::
+    compute_swept_band_layers() const {
+        if (!moving_domain || bdf_coeffs.empty()) {
+            return numbers::invalid_unsigned_int;
+        }
+        const unsigned int bdf_type = bdf_coeffs.size() - 1;
+        const double distance =
+                bdf_type * levelset_function->get_speed() * tau;
+        return static_cast<unsigned int>(std::ceil(distance / h)) + 1;
+    }
+
+
+    template<int dim>
+    const FEValues<dim> *CutFEMProblem<dim>::
+    get_previous_step_fe_values(
+            const unsigned int k,
+            const FEValues<dim> &fe_values,
+            Vector<double> &local_dof_values,
+            std::unique_ptr<FEValues<dim>> &extension_fe_values) const {
+        const typename Triangulation<dim>::active_cell_iterator cell =
+                fe_values.get_cell();
+        if (dof_histories[k].get_local_dof_values(cell, solutions[k],
+                                                  local_dof_values)) {
+            // The cell had the same element in step k, so the shape functions
+            // of fe_values can be used.
+            return &fe_values;
+        }
+        if (!extend_previous_solutions) {
+            return nullptr;
+        }
+        typename Triangulation<dim>::active_cell_iterator extension_cell;
+        if (!dof_histories[k].find_extension_cell(cell, extension_cell)) {
+            throw std::runtime_error(
+                    "No active cell to extend the previous solution from was "
+                    "found: the band of active cells is too small for the "
+                    "movement of the domain.");
+        }
+        dof_histories[k].get_local_dof_values(extension_cell, solutions[k],
+                                              local_dof_values);
+
+        // Map the quadrature points of this cell to the reference cell of the
+        // extension cell, and evaluate the polynomial of that cell there.
+        const Mapping<dim> &mapping = mapping_collection[0];
+        std::vector<Point<dim>> unit_points(fe_values.n_quadrature_points);
+        for (unsigned int q = 0; q < fe_values.n_quadrature_points; ++q) {
+            unit_points[q] = mapping.transform_real_to_unit_cell(
+                    extension_cell, fe_values.quadrature_point(q));
+        }
+        const Quadrature<dim> extension_quadrature(unit_points);
+        extension_fe_values = std::make_unique<FEValues<dim>>(
+                mapping, fe_collection[0], extension_quadrature,
+                update_values | update_gradients);
+        extension_fe_values->reinit(extension_cell);
+        return extension_fe_values.get();
     }
 
 
@@ -859,6 +1432,9 @@ namespace utils::problems {
         
         rhs.reinit(locally_owned_dofs, mpi_communicator);
 
+        stabilized_faces->update(*dof_handlers.front(),
+                                 compute_swept_band_layers());
+
         DynamicSparsityPattern dsp(locally_relevant_dofs);
         make_sparsity_pattern_for_stabilized(dsp, 
                                              *dof_handlers.front());
@@ -872,6 +1448,15 @@ namespace utils::problems {
                                             dsp,
                                             mpi_communicator);
         }
+        if (bdf_terms_by_mass_matrix) {
+            mass_matrix.reinit(locally_owned_dofs,
+                               locally_owned_dofs,
+                               dsp,
+                               mpi_communicator);
+        }
+        // The matrices were recreated, possibly over redistributed dofs, so
+        // the preconditioner no longer matches them.
+        preconditioner_outdated = true;
     }
 
 
@@ -897,10 +1482,20 @@ namespace utils::problems {
                 face_coupling[c][d] = DoFTools::always;
             }
         }
+        // Only couple the dofs over the faces where the ghost penalty is
+        // added.
+        const auto face_has_flux_coupling =
+                [this](const typename hp::DoFHandler<dim>::active_cell_iterator &cell,
+                       const unsigned int face_index) {
+                    return stabilized_faces->face_has_flux_coupling(
+                            cell, face_index);
+                };
         DoFTools::make_flux_sparsity_pattern(dof_handler,
                                             dsp,
                                             cell_coupling,
-                                            face_coupling);
+                                            face_coupling,
+                                            numbers::invalid_subdomain_id,
+                                            face_has_flux_coupling);
 
         // constraints.condense(dsp);
         SparsityTools::distribute_sparsity_pattern(
@@ -986,6 +1581,91 @@ namespace utils::problems {
         throw std::logic_error("Not implemented: assemble_rhs");
     }
 
+    template<int dim>
+    void CutFEMProblem<dim>::
+    assemble_mass_matrix() {
+        pcout << "Assembling mass matrix" << std::endl;
+        TimerOutput::Scope t(computing_timer, "assembly");
+
+        NonMatching::RegionUpdateFlags region_update_flags;
+        region_update_flags.inside = update_values | update_JxW_values |
+                                     update_quadrature_points;
+
+        // Use the same quadrature as in the rhs assembly, such that the
+        // matrix vector product gives the same BDF-terms.
+        NonMatching::FEValues<dim> cut_fe_values(mapping_collection,
+                                                 fe_collection,
+                                                 q_collection,
+                                                 q_collection1D,
+                                                 region_update_flags,
+                                                 cut_mesh_classifier,
+                                                 levelset_dof_handler,
+                                                 levelset);
+
+        for (const auto &cell : dof_handlers.front()->active_cell_iterators()) {
+            if (cell->is_locally_owned()) {
+                const unsigned int n_dofs = cell->get_fe().dofs_per_cell;
+                std::vector<types::global_dof_index> loc2glb(n_dofs);
+                cell->get_dof_indices(loc2glb);
+
+                cut_fe_values.reinit(cell);
+
+                const std_cxx17::optional<FEValues<dim>> &fe_values_bulk =
+                        cut_fe_values.get_inside_fe_values();
+
+                if (fe_values_bulk) {
+                    assemble_mass_matrix_local_over_cell(*fe_values_bulk,
+                                                         loc2glb);
+                }
+            }
+        }
+        mass_matrix.compress(VectorOperation::add);
+    }
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    assemble_mass_matrix_local_over_cell(
+            const FEValues<dim> &fe_values,
+            const std::vector<types::global_dof_index> &loc2glb) {
+        (void) fe_values;
+        (void) loc2glb;
+        throw std::logic_error(
+                "Not implemented: assemble_mass_matrix_local_over_cell");
+    }
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    add_bdf_terms_by_mass_matrix() {
+        assert(!moving_domain);
+        LA::MPI::Vector bdf_sum;
+        LA::MPI::Vector bdf_terms;
+        vector_pool.acquire_owned(bdf_sum);
+        vector_pool.acquire_owned(bdf_terms);
+
+        // Σ b_k u^k, over the previous solutions.
+        for (unsigned int k = 1; k < solutions.size(); ++k) {
+            bdf_sum.add(bdf_coeffs[k], solutions[k]);
+        }
+        mass_matrix.vmult(bdf_terms, bdf_sum);
+        rhs.add(-1, bdf_terms);
+
+        vector_pool.release(bdf_sum);
+        vector_pool.release(bdf_terms);
+    }
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    assemble_newton_jacobian() {
+        throw std::logic_error("Not implemented: assemble_newton_jacobian");
+    }
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    assemble_nonlinear_terms(LA::MPI::Vector &nonlinear_terms) {
+        (void) nonlinear_terms;
+        throw std::logic_error("Not implemented: assemble_nonlinear_terms");
+    }
+
     template<int dim>
     void CutFEMProblem<dim>::
     assemble_rhs_local_over_cell(const FEValues<dim> &fe_values,
@@ -1038,27 +1718,37 @@ namespace utils::problems {
         pcout << "Solving system" << std::endl;
         TimerOutput::Scope t(computing_timer, "solve");
 
-        if (stationary_stiffness_matrix) {
-            SolverControl cn;
-            PETScWrappers::SparseDirectMUMPS solver(cn, mpi_communicator);
-            solver.set_symmetric_mode(false);
-            LA::MPI::Vector completely_distributed_solution(locally_owned_dofs,
-                                                            mpi_communicator);
-            solver.solve(stiffness_matrix, completely_distributed_solution, rhs);
-            solutions.front() = completely_distributed_solution;
+        LA::MPI::Vector completely_distributed_solution;
+        vector_pool.acquire_owned(completely_distributed_solution);
+        if (linear_solver == LinearSolver::cg_amg ||
+            linear_solver == LinearSolver::cg_jacobi ||
+            linear_solver == LinearSolver::cg_gmg) {
+            // The iterative solvers start from the extrapolated solution.
+            compute_extrapolated_initial_guess(completely_distributed_solution);
+        }
+        LA::MPI::SparseMatrix *system_matrix = &stiffness_matrix;
+        if (!stationary_stiffness_matrix) {
+            // Solve the system (A + C(u_e))u = f. The stationary part A is
+            // added to timedep_stiffness_matrix, since this matrix is set to
+            // zero and assembled again before the next solve anyway.
+            timedep_stiffness_matrix.add(1, stiffness_matrix);
+            system_matrix = &timedep_stiffness_matrix;
+        }
+        if (reduced_basis != nullptr) {
+            reduced_basis_estimate = reduced_basis->solve(
+                    *system_matrix, completely_distributed_solution, rhs);
+            pcout << "   Reduced basis solve with " << reduced_basis->size()
+                  << " modes, relative residual = " << reduced_basis_estimate
+                  << std::endl;
         } else {
-            // TODO fix for Navier-Stokes
-            assert(false);
-            /*
-            SparseDirectUMFPACK inverse;
-            SparseMatrix<double> timedep;
-            timedep.reinit(sparsity_pattern);
-            timedep.copy_from(stiffness_matrix);
-            timedep.add(1, timedep_stiffness_matrix);
-            inverse.initialize(timedep);
-            inverse.vmult(solutions.front(), rhs);
-            */
+            solve_linear_system(*system_matrix, rhs,
+                                completely_distributed_solution);
         }
+        if (snapshot_collector != nullptr) {
+            snapshot_collector->add_snapshot(completely_distributed_solution);
+        }
+        solutions.front() = completely_distributed_solution;
+        vector_pool.release(completely_distributed_solution);
 
         pcout << "   Number of active cells:       "
               << triangulation.n_active_cells() << std::endl;
@@ -1067,6 +1757,570 @@ namespace utils::problems {
     }
 
 
+    template<int dim>
+    void CutFEMProblem<dim>::
+    compute_extrapolated_initial_guess(LA::MPI::Vector &initial_guess) {
+        initial_guess = 0;
+        if (solutions.size() < extrap_coeffs.size()) {
+            // No history yet, e.g. for a stationary problem.
+            return;
+        }
+
+        if (!moving_domain) {
+            // All the steps use the same dofs, so the extrapolation is a
+            // linear combination of the solution vectors.
+            LA::MPI::Vector previous_solution;
+            vector_pool.acquire_owned(previous_solution);
+            for (unsigned int k = 1; k < extrap_coeffs.size(); ++k) {
+                previous_solution = solutions[k];
+                initial_guess.add(extrap_coeffs[k], previous_solution);
+            }
+            vector_pool.release(previous_solution);
+            return;
+        }
+
+        // For a moving domain, the previous solutions are read out cell by
+        // cell through dof_histories, and written to the dofs of the current
+        // step. The cells that were not active in all the previous steps are
+        // left at zero.
+        const IndexSet owned_dofs = initial_guess.locally_owned_elements();
+        std::vector<types::global_dof_index> loc2glb;
+        Vector<double> local_dof_values;
+        Vector<double> local_extrapolation;
+        for (const auto &cell : dof_handlers.front()->active_cell_iterators()) {
+            if (!cell->is_locally_owned() ||
+                cell->get_fe().n_dofs_per_cell() == 0) {
+                continue;
+            }
+            loc2glb.resize(cell->get_fe().n_dofs_per_cell());
+            cell->get_dof_indices(loc2glb);
+            local_extrapolation.reinit(loc2glb.size());
+
+            bool active_in_history = true;
+            for (unsigned int k = 1; k < extrap_coeffs.size(); ++k) {
+                if (!dof_histories[k].get_local_dof_values(
+                        cell, solutions[k], local_dof_values) ||
+                    dof_histories[k].active_fe_index(cell) !=
+                    cell->active_fe_index()) {
+                    active_in_history = false;
+                    break;
+                }
+                local_extrapolation.add(extrap_coeffs[k], local_dof_values);
+            }
+            if (!active_in_history) {
+                continue;
+            }
+            for (unsigned int i = 0; i < loc2glb.size(); ++i) {
+                if (owned_dofs.is_element(loc2glb[i])) {
+                    initial_guess(loc2glb[i]) = local_extrapolation[i];
+                }
+            }
+        }
+        initial_guess.compress(VectorOperation::insert);
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    solve_linear_system(LA::MPI::SparseMatrix &matrix,
+                        LA::MPI::Vector &rhs_vector,
+                        LA::MPI::Vector &solution) {
+        if (linear_solver == LinearSolver::cg_amg ||
+            linear_solver == LinearSolver::cg_jacobi ||
+            linear_solver == LinearSolver::cg_gmg) {
+            if (preconditioner_needs_setup()) {
+                setup_preconditioner(matrix);
+            }
+            if (krylov_recycling) {
+                prepare_deflation_vectors(matrix);
+            }
+            unsigned int iterations;
+            if (linear_solver == LinearSolver::cg_amg) {
+                iterations = run_cg(matrix, rhs_vector, solution,
+                                    *amg_preconditioner, krylov_recycling);
+            } else if (linear_solver == LinearSolver::cg_gmg) {
+                iterations = run_cg(matrix, rhs_vector, solution,
+                                    *multigrid_preconditioner,
+                                    krylov_recycling);
+            } else {
+                iterations = run_cg(matrix, rhs_vector, solution,
+                                    *jacobi_preconditioner, krylov_recycling);
+            }
+            linear_solver_iterations = iterations;
+            pcout << "   Solved in " << iterations << " CG iterations."
+                  << std::endl;
+
+            if (preconditioner_base_iterations == 0) {
+                preconditioner_base_iterations = std::max(iterations, 1u);
+            } else if (iterations > preconditioner_rebuild_factor *
+                                    preconditioner_base_iterations) {
+                pcout << "   The preconditioner is rebuilt before the next "
+                         "solve." << std::endl;
+                preconditioner_outdated = true;
+            }
+            return;
+        }
+        if (linear_solver == LinearSolver::direct_refined) {
+            solve_linear_system_refined(matrix, rhs_vector, solution);
+            return;
+        }
+
+        SolverControl cn;
+        PETScWrappers::SparseDirectMUMPS solver(cn, mpi_communicator);
+        // With the symmetric mode, MUMPS computes an LDL^T factorization.
+        solver.set_symmetric_mode(linear_solver ==
+                                  LinearSolver::direct_symmetric);
+        solver.solve(matrix, solution, rhs_vector);
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    solve_linear_system_refined(LA::MPI::SparseMatrix &matrix,
+                                LA::MPI::Vector &rhs_vector,
+                                LA::MPI::Vector &solution) {
+        // Enable the block low-rank factorization in MUMPS (ICNTL(35)), with
+        // the dropping tolerance CNTL(7). The options are read from the
+        // PETSc options database when the matrix is factorized, and are
+        // removed again afterwards, such that they only affect this solver.
+        std::ostringstream tolerance;
+        tolerance << low_rank_tolerance;
+        PetscOptionsSetValue(nullptr, "-mat_mumps_icntl_35", "2");
+        PetscOptionsSetValue(nullptr, "-mat_mumps_cntl_7",
+                             tolerance.str().c_str());
+
+        // The factorization is computed in the first solve, and reused by
+        // the solver object in the following refinement steps.
+        SolverControl cn;
+        PETScWrappers::SparseDirectMUMPS solver(cn, mpi_communicator);
+
+        LA::MPI::Vector residual;
+        LA::MPI::Vector correction;
+        vector_pool.acquire_owned(residual);
+        vector_pool.acquire_owned(correction);
+
+        // Refine x_{k+1} = x_k + LU^{-1}(b - Ax_k), starting from x_0 = 0.
+        const double rhs_norm = rhs_vector.l2_norm();
+        solution = 0;
+        residual = rhs_vector;
+        refinement_residuals.clear();
+        bool converged = rhs_norm == 0;
+        for (unsigned int k = 0; k < max_refinement_steps && !converged; ++k) {
+            solver.solve(matrix, correction, residual);
+            solution += correction;
+
+            matrix.vmult(residual, solution);
+            residual.sadd(-1, 1, rhs_vector);
+            refinement_residuals.push_back(residual.l2_norm() / rhs_norm);
+            pcout << "   Refinement step " << k
+                  << ": relative residual = " << refinement_residuals.back()
+                  << std::endl;
+            converged = refinement_residuals.back() <= linear_solver_tolerance;
+        }
+        if (!converged) {
+            pcout << "   WARNING: the iterative refinement did not reach the "
+                     "tolerance " << linear_solver_tolerance << " in "
+                  << max_refinement_steps << " steps." << std::endl;
+        }
+
+        vector_pool.release(residual);
+        vector_pool.release(correction);
+        PetscOptionsClearValue(nullptr, "-mat_mumps_icntl_35");
+        PetscOptionsClearValue(nullptr, "-mat_mumps_cntl_7");
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    solve_linear_system_cg(LA::MPI::SparseMatrix &matrix,
+                           LA::MPI::Vector &rhs_vector,
+                           LA::MPI::Vector &solution,
+                           const LinearSolver method) {
+        assert(method == LinearSolver::cg_amg ||
+               method == LinearSolver::cg_jacobi);
+        unsigned int iterations;
+        if (method == LinearSolver::cg_amg) {
+            LA::MPI::PreconditionAMG preconditioner;
+            LA::MPI::PreconditionAMG::AdditionalData data;
+#ifdef USE_PETSC_LA
+            data.symmetric_operator = true;
+#else
+            data.elliptic = true;
+#endif
+            preconditioner.initialize(matrix, data);
+            iterations = run_cg(matrix, rhs_vector, solution, preconditioner,
+                                false);
+        } else {
+            LA::MPI::PreconditionJacobi preconditioner;
+            preconditioner.initialize(matrix);
+            iterations = run_cg(matrix, rhs_vector, solution, preconditioner,
+                                false);
+        }
+        pcout << "   Solved in " << iterations << " CG iterations."
+              << std::endl;
+    }
+
+
+    template<int dim>
+    template<typename PreconditionerType>
+    unsigned int CutFEMProblem<dim>::
+    run_cg(LA::MPI::SparseMatrix &matrix,
+           LA::MPI::Vector &rhs_vector,
+           LA::MPI::Vector &solution,
+           const PreconditionerType &preconditioner,
+           const bool recycle) {
+        // The tolerance is relative to the rhs, so it is zero for a zero rhs,
+        // which the solution is anyway.
+        const double rhs_norm = rhs_vector.l2_norm();
+        if (rhs_norm == 0) {
+            solution = 0;
+            return 0;
+        }
+        if (recycle) {
+            return deflated_cg.solve(
+                    matrix, solution, rhs_vector, preconditioner,
+                    linear_solver_tolerance * rhs_norm, matrix.m());
+        }
+        SolverControl solver_control(matrix.m(),
+                                     linear_solver_tolerance * rhs_norm);
+        if constexpr (std::is_same<PreconditionerType,
+                GeometricMultigrid<dim, LA::MPI::SparseMatrix,
+                        LA::MPI::Vector>>::value) {
+            // The solvers of the linear algebra package only take their own
+            // preconditioners.
+            SolverCG<LA::MPI::Vector> solver(solver_control);
+            solver.solve(matrix, solution, rhs_vector, preconditioner);
+        } else {
+#ifdef USE_PETSC_LA
+            LA::SolverCG solver(solver_control, mpi_communicator);
+#else
+            LA::SolverCG solver(solver_control);
+#endif
+            solver.solve(matrix, solution, rhs_vector, preconditioner);
+        }
+        return solver_control.last_step();
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    prepare_deflation_vectors(const LA::MPI::SparseMatrix &matrix) {
+        std::vector<LA::MPI::Vector> &deflation_vectors =
+                deflated_cg.get_deflation_vectors();
+        if (deflation_vectors.empty()) {
+            return;
+        }
+        if (moving_domain && dof_histories.size() > 1) {
+            // The deflation vectors were computed in the previous time step,
+            // so they are moved to the dofs of the current step.
+            for (LA::MPI::Vector &vector : deflation_vectors) {
+                transfer_from_previous_step(vector);
+            }
+        } else if (deflation_vectors.front().size() != matrix.m()) {
+            deflated_cg.clear();
+        }
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    transfer_from_previous_step(LA::MPI::Vector &vector) {
+        LA::MPI::Vector previous;
+        vector_pool.acquire_ghosted(previous);
+        previous = vector;
+        vector = 0;
+
+        const IndexSet owned_dofs = vector.locally_owned_elements();
+        std::vector<types::global_dof_index> loc2glb;
+        Vector<double> local_dof_values;
+        for (const auto &cell : dof_handlers.front()->active_cell_iterators()) {
+            if (!cell->is_locally_owned() ||
+                cell->get_fe().n_dofs_per_cell() == 0 ||
+                !dof_histories[1].get_local_dof_values(cell, previous,
+                                                       local_dof_values) ||
+                dof_histories[1].active_fe_index(cell) !=
+                cell->active_fe_index()) {
+                continue;
+            }
+            loc2glb.resize(cell->get_fe().n_dofs_per_cell());
+            cell->get_dof_indices(loc2glb);
+            for (unsigned int i = 0; i < loc2glb.size(); ++i) {
+                if (owned_dofs.is_element(loc2glb[i])) {
+                    vector(loc2glb[i]) = local_dof_values[i];
+                }
+            }
+        }
+        vector.compress(VectorOperation::insert);
+        vector_pool.release(previous);
+    }
+
+
+    template<int dim>
+    bool CutFEMProblem<dim>::
+    preconditioner_needs_setup() const {
+        bool exists;
+        if (linear_solver == LinearSolver::cg_amg) {
+            exists = amg_preconditioner != nullptr;
+        } else if (linear_solver == LinearSolver::cg_gmg) {
+            exists = multigrid_preconditioner != nullptr;
+        } else {
+            exists = jacobi_preconditioner != nullptr;
+        }
+        return !reuse_preconditioner || preconditioner_outdated || !exists;
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    setup_preconditioner(const LA::MPI::SparseMatrix &matrix) {
+        TimerOutput::Scope t(computing_timer, "preconditioner setup");
+        pcout << "   Set up the preconditioner" << std::endl;
+        amg_preconditioner.reset();
+        jacobi_preconditioner.reset();
+        multigrid_preconditioner.reset();
+        if (linear_solver == LinearSolver::cg_amg) {
+            amg_preconditioner = std::make_unique<LA::MPI::PreconditionAMG>();
+            LA::MPI::PreconditionAMG::AdditionalData data;
+#ifdef USE_PETSC_LA
+            data.symmetric_operator = true;
+#else
+            data.elliptic = true;
+#endif
+            amg_preconditioner->initialize(matrix, data);
+#ifdef USE_PETSC_LA
+            // Else PETSc sets up the preconditioner again in the next solve
+            // if the values of the matrix changed.
+            PCSetReusePreconditioner(amg_preconditioner->get_pc(), PETSC_TRUE);
+#endif
+        } else if (linear_solver == LinearSolver::cg_gmg) {
+            setup_multigrid(matrix);
+        } else {
+            jacobi_preconditioner =
+                    std::make_unique<LA::MPI::PreconditionJacobi>();
+            jacobi_preconditioner->initialize(matrix);
+#ifdef USE_PETSC_LA
+            PCSetReusePreconditioner(jacobi_preconditioner->get_pc(),
+                                     PETSC_TRUE);
+#endif
+        }
+        preconditioner_base_iterations = 0;
+        preconditioner_outdated = false;
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    setup_multigrid(const LA::MPI::SparseMatrix &matrix) {
+        if (!level_problem_factory) {
+            throw std::invalid_argument(
+                    "LinearSolver::cg_gmg needs the problems of the levels, "
+                    "see set_multigrid().");
+        }
+        if (multigrid_coarse_refines >= n_refines) {
+            throw std::invalid_argument(
+                    "The coarsest multigrid level must have fewer refinements "
+                    "than the problem.");
+        }
+        const double time = levelset_function->get_time();
+
+        multigrid_levels.clear();
+        std::vector<const hp::DoFHandler<dim> *> level_dof_handlers;
+        std::vector<const LA::MPI::SparseMatrix *> level_matrices;
+        for (unsigned int refines = multigrid_coarse_refines;
+             refines < n_refines; ++refines) {
+            pcout << "   Assemble the multigrid level with " << refines
+                  << " refinements" << std::endl;
+            multigrid_levels.push_back(level_problem_factory(refines));
+            CutFEMProblem<dim> &level = *multigrid_levels.back();
+            level.tau = tau;
+            level.bdf_coeffs = bdf_coeffs;
+            level.crank_nicholson = crank_nicholson;
+            level.assemble_multigrid_level(time, in_time_loop);
+
+            level_dof_handlers.push_back(level.dof_handlers.front().get());
+            level_matrices.push_back(&level.stiffness_matrix);
+        }
+        level_dof_handlers.push_back(dof_handlers.front().get());
+        level_matrices.push_back(&matrix);
+
+        multigrid_preconditioner = std::make_unique<GeometricMultigrid<
+                dim, LA::MPI::SparseMatrix, LA::MPI::Vector>>(
+                multigrid_smoothing_steps, multigrid_damping);
+        multigrid_preconditioner->initialize(level_dof_handlers,
+                                             level_matrices,
+                                             mpi_communicator);
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    assemble_multigrid_level(const double time, const bool time_loop) {
+        // The mesh is kept when the preconditioner is set up again.
+        if (triangulation.n_quads() == 0) {
+            make_grid(triangulation);
+            set_grid_size();
+            setup_quadrature();
+        }
+        set_function_times(time);
+        setup_level_set();
+        cut_mesh_classifier.reclassify();
+        solutions.clear();
+        dof_handlers.clear();
+        dof_handlers.emplace_front(new hp::DoFHandler<dim>(triangulation));
+        setup_fe_collection();
+        distribute_dofs(dof_handlers.front());
+
+        locally_owned_dofs = dof_handlers.front()->locally_owned_dofs();
+        DoFTools::extract_locally_relevant_dofs(*dof_handlers.front(),
+                                                locally_relevant_dofs);
+        push_new_solution();
+
+        initialize_matrices();
+        pre_matrix_assembly();
+        if (time_loop) {
+            assemble_matrix();
+        } else {
+            assemble_system();
+        }
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    project_onto_cut_space(const Function<dim> &function,
+                           LA::MPI::Vector &projection) {
+        pcout << "Project onto the cut finite element space" << std::endl;
+        const hp::DoFHandler<dim> &dof_handler = *dof_handlers.front();
+        const unsigned int n_components = fe_collection.n_components();
+        assert(function.n_components == n_components);
+
+        stabilized_faces->update(dof_handler);
+        DynamicSparsityPattern dsp(locally_relevant_dofs);
+        make_sparsity_pattern_for_stabilized(dsp, dof_handler);
+        LA::MPI::SparseMatrix projection_matrix;
+        projection_matrix.reinit(locally_owned_dofs,
+                                 locally_owned_dofs,
+                                 dsp,
+                                 mpi_communicator);
+        LA::MPI::Vector projection_rhs(locally_owned_dofs, mpi_communicator);
+
+        // Add the ghost penalty to each component, such that the mass matrix
+        // is well conditioned, however the cells are cut.
+        std::vector<std::unique_ptr<stabilization::JumpStabilization<
+                dim, FEValuesExtractors::Scalar>>> component_stabs;
+        for (unsigned int c = 0; c < n_components; ++c) {
+            component_stabs.emplace_back(
+                    new stabilization::JumpStabilization<
+                            dim, FEValuesExtractors::Scalar>(
+                            dof_handler, mapping_collection,
+                            cut_mesh_classifier, constraints));
+            component_stabs.back()->set_faces_to_stabilize(stabilized_faces);
+            component_stabs.back()->set_weight_function(
+                    stabilization::taylor_weights);
+            component_stabs.back()->set_extractor(
+                    FEValuesExtractors::Scalar(c));
+        }
+        const double beta_0 = 0.1;
+        const double gamma_M = beta_0 * element_order * (element_order + 1);
+
+        NonMatching::RegionUpdateFlags region_update_flags;
+        region_update_flags.inside = update_values | update_JxW_values |
+                                     update_quadrature_points;
+
+        NonMatching::FEValues<dim> cut_fe_values(mapping_collection,
+                                                 fe_collection,
+                                                 q_collection,
+                                                 q_collection1D,
+                                                 region_update_flags,
+                                                 cut_mesh_classifier,
+                                                 levelset_dof_handler,
+                                                 levelset);
+
+        std::vector<Vector<double>> function_values;
+        for (const auto &cell : dof_handler.active_cell_iterators()) {
+            if (!cell->is_locally_owned()) {
+                continue;
+            }
+            const unsigned int n_dofs = cell->get_fe().dofs_per_cell;
+            std::vector<types::global_dof_index> loc2glb(n_dofs);
+            cell->get_dof_indices(loc2glb);
+
+            cut_fe_values.reinit(cell);
+
+            const std_cxx17::optional<FEValues<dim>> &fe_values_bulk =
+                    cut_fe_values.get_inside_fe_values();
+
+            if (fe_values_bulk) {
+                const FEValues<dim> &fe_v = *fe_values_bulk;
+                const FiniteElement<dim> &fe = fe_v.get_fe();
+                FullMatrix<double> local_matrix(n_dofs, n_dofs);
+                Vector<double> local_rhs(n_dofs);
+
+                function_values.resize(fe_v.n_quadrature_points,
+                                       Vector<double>(n_components));
+                function.vector_value_list(fe_v.get_quadrature_points(),
+                                           function_values);
+
+                for (unsigned int q : fe_v.quadrature_point_indices()) {
+                    for (const unsigned int i : fe_v.dof_indices()) {
+                        const unsigned int component_i =
+                                fe.system_to_component_index(i).first;
+                        for (const unsigned int j : fe_v.dof_indices()) {
+                            if (fe.system_to_component_index(j).first ==
+                                component_i) {
+                                local_matrix(i, j) +=
+                                        fe_v.shape_value(j, q) *
+                                        fe_v.shape_value(i, q) *
+                                        fe_v.JxW(q); // (u, v)
+                            }
+                        }
+                        local_rhs(i) += function_values[q][component_i] *
+                                        fe_v.shape_value(i, q) *
+                                        fe_v.JxW(q); // (f, v)
+                    }
+                }
+                projection_matrix.add(loc2glb, local_matrix);
+                projection_rhs.add(loc2glb, local_rhs);
+            }
+
+            for (auto &stab : component_stabs) {
+                stab->compute_stabilization(cell);
+                stab->add_stabilization_to_matrix(gamma_M, projection_matrix);
+            }
+        }
+        projection_matrix.compress(VectorOperation::add);
+        projection_rhs.compress(VectorOperation::add);
+
+        LA::MPI::Vector completely_distributed_projection;
+        vector_pool.acquire_owned(completely_distributed_projection);
+        completely_distributed_projection = 0;
+        solve_linear_system_cg(projection_matrix, projection_rhs,
+                               completely_distributed_projection,
+                               LinearSolver::cg_jacobi);
+        projection = completely_distributed_projection;
+        vector_pool.release(completely_distributed_projection);
+    }
+
+
+    template<int dim>
+    double CutFEMProblem<dim>::
+    compute_newton_residual(const LA::MPI::Vector &u,
+                            LA::MPI::Vector &residual) {
+        // The non-linear terms are assembled using the solution in
+        // solutions.front(), so update the ghosted vector first.
+        solutions.front() = u;
+
+        LA::MPI::Vector nonlinear_terms(locally_owned_dofs, mpi_communicator);
+        assemble_nonlinear_terms(nonlinear_terms);
+
+        // R(u) = Au + N(u) - f
+        stiffness_matrix.vmult(residual, u);
+        residual += nonlinear_terms;
+        residual -= rhs;
+        return residual.l2_norm();
+    }
+
+
     template<int dim>
     double CutFEMProblem<dim>::
     compute_condition_number() {
@@ -1138,11 +2392,29 @@ namespace utils::problems {
         data_out_levelset.add_data_vector(subdomain, "subdomain");
         data_out_levelset.build_patches();
 
-        data_out_levelset.write_vtu_with_pvtu_record(
-            "", "levelset-d" + std::to_string(dim)
-                + "o" + std::to_string(element_order)
-                + "r" + std::to_string(n_refines),
-            time_step, mpi_communicator, 2, 8);
+        write_data_out(data_out_levelset, "levelset", time_step);
+    }
+
+
+    template<int dim>
+    void CutFEMProblem<dim>::
+    write_data_out(const DataOut<dim> &data_out,
+                   const std::string &name,
+                   const int time_step) const {
+        const std::string suffix = "-d" + std::to_string(dim)
+                                   + "o" + std::to_string(element_order)
+                                   + "r" + std::to_string(n_refines);
+        if (output_format == OutputFormat::vtu) {
+            data_out.write_vtu_with_pvtu_record(
+                "", name + suffix, time_step, mpi_communicator, 2, 8);
+            return;
+        }
+        if (!hdf5_output) {
+            hdf5_output = std::make_unique<HDF5Output<dim>>(
+                    "output" + suffix, mpi_communicator, output_float32,
+                    output_compression_level);
+        }
+        hdf5_output->write(data_out, name, start_time + time_step * tau);
     }
 
 
@@ -57,10 +57,22 @@ using namespace dealii::LinearAlgebraTrilinos;
 
 #include <deque>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
+#include "anderson_acceleration.h"
+#include "deflated_cg.h"
+#include "dof_history.h"
+#include "geometric_multigrid.h"
+#include "hdf5_output.h"
+#include "reduced_basis.h"
+#include "stabilized_faces.h"
+#include "vector_pool.h"
+#include "vectorized_function.h"
 #include "stabilization/jump_stabilization.h"
 
 
@@ -73,6 +85,48 @@ namespace utils::problems {
     using NonMatching::LocationToLevelSet;
 
 
+    /**
+     * The method used to solve the linear systems in
+     * CutFEMProblem::solve_linear_system().
+     */
+    enum class LinearSolver {
+        // LU factorization with MUMPS, works for all the problems.
+        direct,
+        // LDL^T factorization with MUMPS. The matrix must be symmetric.
+        direct_symmetric,
+        // CG preconditioned with AMG. The matrix must be symmetric positive
+        // definite.
+        cg_amg,
+        // CG preconditioned with the diagonal of the matrix. Used for
+        // ghost penalty stabilized mass matrices, which are well
+        // conditioned independently of h and of how the cells are cut.
+        cg_jacobi,
+        // LU factorization with MUMPS, where the factors are compressed to
+        // a reduced accuracy with block low-rank approximations. Full
+        // accuracy is recovered by iterative refinement in double precision,
+        // see CutFEMProblem::set_refinement_parameters().
+        direct_refined,
+        // CG preconditioned with one V-cycle of geometric multigrid over the
+        // meshes with fewer global refinements, each with its own cut space,
+        // see CutFEMProblem::set_multigrid(). The matrix must be symmetric
+        // positive definite.
+        cg_gmg
+    };
+
+
+    /**
+     * The format of the files written by output_results() and
+     * output_levelset(), see CutFEMProblem::set_output_format().
+     */
+    enum class OutputFormat {
+        // One .vtu-file per process and step, and a .pvtu-record per step.
+        vtu,
+        // A single HDF5 file for the whole run, written with parallel I/O,
+        // and an XDMF file describing the time series, see HDF5Output.
+        hdf5
+    };
+
+
     struct ErrorBase {
         double h = 0;
         double tau = 0;
@@ -102,32 +156,317 @@ namespace utils::problems {
 
         virtual double
         get_speed();
+
+        /**
+         * Return the velocity of the domain at the given point. This is used
+         * to compute the band of active cells locally, see
+         * CutFEMProblem::set_local_active_band(). The default implementation
+         * returns get_velocity(), which is correct for rigid translations,
+         * but should be overridden for rotating or deforming domains.
+         */
+        virtual Tensor<1, dim>
+        get_local_velocity(const Point<dim> &point);
+
+        /**
+         * Evaluate the level set in VectorizedArray<double>::size() points
+         * at once, given in structure-of-arrays form. The default
+         * implementation calls value() for each lane; the analytical level
+         * sets override it with SIMD arithmetic.
+         */
+        virtual VectorizedArray<double>
+        vectorized_value(const Point<dim, VectorizedArray<double>> &points) const;
+
+        /**
+         * Evaluate the level set in all the points through
+         * vectorized_value(), in batches of VectorizedArray<double>::size()
+         * points. This is used e.g. by distribute_dofs(), to evaluate the
+         * level set in all the cell centers.
+         */
+        void
+        value_list(const std::vector<Point<dim>> &points,
+                   std::vector<double> &values,
+                   unsigned int component = 0) const override;
     };
 
 
     template<int dim>
     class CutFEMProblem {
     public:
+        /**
+         * Create the same problem as this one on the mesh with the given
+         * number of global refinements. Used to make the levels of
+         * LinearSolver::cg_gmg, see set_multigrid().
+         */
+        using LevelProblemFactory =
+                std::function<std::unique_ptr<CutFEMProblem<dim>>(unsigned int)>;
+
         CutFEMProblem(unsigned int n_refines,
                       int element_order,
                       bool write_output,
                       LevelSet<dim> &levelset_func,
                       bool stabilized = true,
                       bool stationary = false,
-                      bool compute_error = true);
+                      bool compute_error = true,
+                      const MPI_Comm &mpi_communicator = MPI_COMM_WORLD);
+
+        // The problems of the multigrid levels are deleted through this class.
+        virtual ~CutFEMProblem() = default;
 
         ErrorBase *
         run_step();
 
+        /**
+         * Solve a stationary non-linear problem with fixed point (Picard)
+         * iteration. If the error is computed, the iteration is stopped when
+         * the difference in the error between two iterations is below tol.
+         * Else, it is stopped when the l2-norm of the fixed point residual
+         * g(u_k) - u_k is below tol.
+         *
+         * The iteration can be accelerated with Anderson acceleration, see
+         * set_anderson_acceleration().
+         */
         ErrorBase *
-        run_step_non_linear(double tol);
+        run_step_non_linear(double tol, unsigned int max_iterations = 100);
+
+        /**
+         * Use Anderson acceleration in the fixed point iteration in
+         * run_step_non_linear(). A depth of 0 gives a (relaxed) fixed point
+         * iteration, which is the default.
+         *
+         * @param depth: the number of previous iterates used.
+         * @param relaxation: the relaxation parameter in (0, 1].
+         */
+        void
+        set_anderson_acceleration(unsigned int depth, double relaxation = 1);
+
+        /**
+         * Solve a stationary non-linear problem with Newton's method.
+         *
+         * The residual is R(u) = Au + N(u) - f, where A is the stiffness
+         * matrix assembled by assemble_matrix(), f is the rhs assembled by
+         * assemble_rhs(), and N(u) are the non-linear terms assembled by
+         * assemble_nonlinear_terms(). The Jacobian of N(u) is assembled by
+         * assemble_newton_jacobian(). A backtracking line search is used on
+         * the norm of the residual, and the iteration is stopped when
+         * ||R(u)|| < tol, so no exact solution is needed.
+         *
+         * @param tol: tolerance for the l2-norm of the non-linear residual.
+         * @param max_iterations: the maximal number of Newton steps.
+         */
+        ErrorBase *
+        run_step_newton(double tol, unsigned int max_iterations = 25);
+
+        /**
+         * Compute the BDF-terms -(Σ b_k u^k, v) of the rhs as the matrix
+         * vector product -M(Σ b_k u^k), where M is the (cut) mass matrix,
+         * instead of integrating the previous solutions over all the cells
+         * in each time step. This is only used by run_time(), since the
+         * domain has to be stationary for M to be assembled once.
+         */
+        void
+        set_bdf_terms_by_mass_matrix(bool use_mass_matrix);
+
+        /**
+         * For moving domains: extend the previous solutions onto cells that
+         * were not active in the previous steps, by extrapolating the
+         * polynomial of a neighboring active cell, see
+         * get_previous_step_fe_values(). The band of active cells outside
+         * the physical domain then only has to cover the movement of the
+         * domain over bdf_type time steps and one cell layer, without the
+         * safety factor of compute_size_of_bound(). If
+         * mesh_bound_multiplier * h is larger, that band is used.
+         */
+        void
+        set_extend_previous_solutions(bool extend);
+
+        /**
+         * For moving domains: compute the band of active cells outside the
+         * physical domain for each cell, from the normal velocity of the
+         * interface near the cell, instead of from the maximum speed
+         * get_speed() of the domain. Only the interface normal velocity
+         * moves the domain, so e.g. the cells on the sides of a translating
+         * sphere, and the cells behind it, are not activated. See
+         * distribute_dofs_in_band().
+         */
+        void
+        set_local_active_band(bool local_band);
+
+        /**
+         * Set the method used to solve the linear systems. The default is an
+         * LU factorization, which is needed for the saddle point systems of
+         * the flow problems. For symmetric (positive definite) systems, an
+         * LDL^T factorization needs about half the memory, and CG with AMG
+         * scales linearly with the number of dofs. In the time loops, the
+         * iterative solvers start from the extrapolation of the previous
+         * solutions, see compute_extrapolated_initial_guess().
+         *
+         * @param tolerance: the relative tolerance of the residual, only used
+         * by the iterative solvers.
+         */
+        void
+        set_linear_solver(LinearSolver solver, double tolerance = 1e-10);
+
+        /**
+         * Keep the preconditioner of the iterative solvers between the calls
+         * to solve(), instead of setting it up again for each system. The
+         * preconditioner is rebuilt when the dofs are redistributed or the
+         * matrices are reinitialized, e.g. in each step on a moving domain,
+         * or when the number of CG iterations exceeds rebuild_factor times the
+         * number of iterations of the first solve after the last setup.
+         * Reuse is enabled by default.
+         *
+         * @param rebuild_factor: the allowed growth of the number of
+         * iterations before the preconditioner is rebuilt.
+         */
+        void
+        set_preconditioner_reuse(bool reuse, double rebuild_factor = 2);
+
+        /**
+         * Set the parameters of LinearSolver::direct_refined. The relative
+         * tolerance of the refinement is the tolerance given to
+         * set_linear_solver().
+         *
+         * @param low_rank_tolerance: the dropping tolerance of the block
+         * low-rank compression of the factors in MUMPS. A larger tolerance
+         * gives smaller factors, but more refinement steps.
+         * @param max_steps: the maximal number of refinement steps.
+         */
+        void
+        set_refinement_parameters(double low_rank_tolerance,
+                                  unsigned int max_steps = 10);
+
+        /**
+         * Return the relative residuals ||b - Ax_k|| / ||b|| of the
+         * refinement steps of the last solve with
+         * LinearSolver::direct_refined. If these stagnate, the factorization
+         * is too inaccurate for the conditioning of the system.
+         */
+        const std::vector<double> &
+        get_refinement_residual_history() const;
+
+        /**
+         * Add the solution of each call to solve() as a snapshot to the
+         * given reduced basis, e.g. in the training runs of a parameter
+         * study. Pass nullptr to stop collecting snapshots.
+         */
+        void
+        set_snapshot_collector(ReducedBasis<LA::MPI::Vector> *collector);
+
+        /**
+         * Solve the linear systems in the span of the given reduced basis,
+         * instead of the full order solve, see ReducedBasis::solve(). The
+         * full order system is still assembled, only its solve is replaced.
+         * The basis must be computed from snapshots with the same dofs. Pass
+         * nullptr to use the full order solver again.
+         */
+        void
+        set_reduced_basis(const ReducedBasis<LA::MPI::Vector> *basis);
+
+        /**
+         * Return the relative residual of the last reduced basis solve, which
+         * is used as an estimate of the reduced basis error.
+         */
+        double
+        get_reduced_basis_estimate() const;
+
+        /**
+         * Use deflated CG for the iterative solvers, where the deflation
+         * subspace is recycled from one solve to the next, see DeflatedCG.
+         * For a moving domain, the subspace is transferred to the dofs of the
+         * new time step before each solve.
+         *
+         * @param n_deflation_vectors: the dimension of the deflation subspace.
+         * @param n_recycled_directions: the number of CG search directions of
+         * each solve used to update the subspace.
+         */
+        void
+        set_krylov_recycling(bool recycle,
+                             unsigned int n_deflation_vectors = 8,
+                             unsigned int n_recycled_directions = 20);
+
+        /**
+         * Set the levels of LinearSolver::cg_gmg. When the preconditioner is
+         * set up, the problem is created, its mesh refined and its matrix
+         * assembled on each level coarse_refines, ..., n_refines - 1 with
+         * the given factory, see GeometricMultigrid. The problems of the
+         * levels must use the same coarse grid, level set and communicator
+         * as this problem. This is implemented for run_step() and
+         * run_time(), but not for moving domains.
+         *
+         * @param coarse_refines: the number of global refinements of the
+         * coarsest level, which is solved with a dense factorization.
+         * @param smoothing_steps: the number of damped Jacobi steps before
+         * and after the coarse grid correction.
+         * @param damping: the damping factor of the Jacobi steps.
+         */
+        void
+        set_multigrid(const LevelProblemFactory &factory,
+                      unsigned int coarse_refines,
+                      unsigned int smoothing_steps = 2,
+                      double damping = 0.6);
+
+        /**
+         * Return the number of iterations of the last solve with one of the
+         * iterative solvers.
+         */
+        unsigned int
+        get_linear_solver_iterations() const;
+
+        /**
+         * Start run_time() and run_moving_domain() at the given time instead
+         * of t = 0, such that step k is at the time start_time + kτ. This is
+         * used to run a time slice, see Parareal.
+         */
+        void
+        set_start_time(double start_time);
+
+        /**
+         * Append a suffix to the name of the csv-file of the errors written
+         * by run_time() and run_moving_domain(), such that problems running
+         * at the same time, e.g. the time slices of Parareal, write to
+         * different files.
+         */
+        void
+        set_error_file_suffix(const std::string &suffix);
+
+        /**
+         * Compute the initial steps in run_time() and run_moving_domain() as
+         * the L2-projection of the analytical solution onto the cut finite
+         * element space, see project_onto_cut_space(), instead of
+         * interpolating it.
+         */
+        void
+        set_project_first_steps(bool project);
 
         LA::MPI::Vector
         get_solution();
 
+        /**
+         * Set the format of the output files. With OutputFormat::hdf5, the
+         * solution and the level set of all the steps are written to the
+         * single file output-d<dim>o<order>r<refines>.h5, which is kept open
+         * for the lifetime of the problem.
+         *
+         * @param float32: store the data of the hdf5 output in single
+         * precision.
+         * @param compression_level: the deflate level 0-9 of the hdf5
+         * output, where 0 means no compression.
+         */
+        void
+        set_output_format(OutputFormat format, bool float32 = false,
+                          unsigned int compression_level = 0);
+
         std::shared_ptr<hp::DoFHandler<dim>>
         get_dof_handler();
 
+        /**
+         * Return the wall times in seconds of the timed sections (assembly,
+         * solve, ...) of the last run with run_step() or run_step_newton(),
+         * summed over all the calls in the run.
+         */
+        const std::map<std::string, double> &
+        get_timings() const;
+
         /**
          * Run a time loop with a BDF-method.
          *
@@ -136,6 +475,10 @@ namespace utils::problems {
          * vector of length exactly 1, then u1 is also interpolated. Else, the
          * argument u1 is ´used as the start up step u1 for BDF-2.
          *
+         * If supplied_solutions holds bdf_type vectors, u_0 is replaced too,
+         * such that the run can be started from a computed solution, e.g.
+         * for a time slice, see set_start_time().
+         *
          * @param u1: is the u1 start up step.
          * @param steps: the number of steps to run.
          * @return an Error object.
@@ -164,6 +507,20 @@ namespace utils::problems {
         write_error_to_file(ErrorBase *error, std::ofstream &file);
 
     protected:
+        /**
+         * Push a new zero solution vector to the front of the solutions
+         * deque. The vector is recycled from vector_pool when possible.
+         */
+        void
+        push_new_solution();
+
+        /**
+         * Remove the oldest solution from the solutions deque, and hand it
+         * back to vector_pool.
+         */
+        void
+        pop_oldest_solution();
+
         void
         set_bdf_coefficients(unsigned int bdf_type);
 
@@ -208,6 +565,75 @@ namespace utils::problems {
         distribute_dofs(std::shared_ptr<hp::DoFHandler<dim>> &dof_handler,
                         double size_of_bound = 0);
 
+        /**
+         * For moving domains: distribute the dofs on the cells in the domain,
+         * and on the band of cells outside it that is needed to evaluate the
+         * previous solutions in the BDF-terms.
+         *
+         * If local_active_band is true, a cell K outside the domain is
+         * active if the level set in its center is smaller than the size of
+         * the bound computed with the speed |v(x_K)·n_K|, where n_K is the
+         * normal of the discrete level set in the cell center. Else one
+         * global size of bound is used, computed with get_speed().
+         */
+        void
+        distribute_dofs_in_band(
+                std::shared_ptr<hp::DoFHandler<dim>> &dof_handler,
+                unsigned int bdf_type,
+                double mesh_bound_multiplier);
+
+        /**
+         * Compute the distance from the physical domain, within which the
+         * cells outside the domain should be active.
+         */
+        double
+        compute_size_of_bound(unsigned int bdf_type,
+                              double mesh_bound_multiplier) const;
+
+        /**
+         * Compute the distance from the physical domain, within which the
+         * cells outside the domain should be active, when the domain moves
+         * with the given speed.
+         */
+        double
+        compute_size_of_bound(unsigned int bdf_type,
+                              double mesh_bound_multiplier,
+                              double speed) const;
+
+        /**
+         * Return the number of layers of cells around the interface that
+         * are checked for changes by StabilizedFaces::update() on a moving
+         * domain. This covers the distance the interface moves in bdf_type
+         * steps, since the last update may be from before the first steps.
+         * For a stationary domain all the cells are checked.
+         */
+        unsigned int
+        compute_swept_band_layers() const;
+
+        /**
+         * Prepare the evaluation of the previous solution solutions[k] on
+         * the cell of fe_values, for a moving domain.
+         *
+         * The local dof values of the previous solution are written to
+         * local_dof_values, and the FEValues object that should be used to
+         * evaluate them is returned. If the cell was active in step k, this
+         * is fe_values itself. Else, if extend_previous_solutions is true,
+         * the polynomial of a neighboring cell that was active in step k is
+         * extrapolated to the quadrature points of fe_values. Then the
+         * returned object is stored in extension_fe_values. If no such cell
+         * is found, std::runtime_error is thrown, since the BDF-terms can't
+         * be computed.
+         *
+         * @return nullptr if the previous solution could not be evaluated
+         * on the cell, when extend_previous_solutions is false.
+         */
+        const FEValues<dim> *
+        get_previous_step_fe_values(
+                unsigned int k,
+                const FEValues<dim> &fe_values,
+                Vector<double> &local_dof_values,
+                std::unique_ptr<FEValues<dim>> &extension_fe_values) const;
+
         virtual void
         initialize_matrices();
 
@@ -262,6 +688,40 @@ namespace utils::problems {
         virtual void
         assemble_rhs(int time_step);
 
+        /**
+         * Assemble the Jacobian of the non-linear terms N(u) into
+         * timedep_stiffness_matrix, linearized around solutions.front().
+         * Used by run_step_newton().
+         */
+        virtual void
+        assemble_newton_jacobian();
+
+        /**
+         * Assemble the vector of the non-linear terms N(u), evaluated in
+         * solutions.front(). Used by run_step_newton().
+         */
+        virtual void
+        assemble_nonlinear_terms(LA::MPI::Vector &nonlinear_terms);
+
+        /**
+         * Assemble the mass matrix (u, v) over the physical domain into
+         * mass_matrix, using assemble_mass_matrix_local_over_cell().
+         */
+        void
+        assemble_mass_matrix();
+
+        virtual void
+        assemble_mass_matrix_local_over_cell(
+                const FEValues<dim> &fe_values,
+                const std::vector<types::global_dof_index> &loc2glb);
+
+        /**
+         * Add the BDF-terms -M(Σ b_k u^k) to the rhs, where the sum is over
+         * the previous solutions in the solutions deque.
+         */
+        void
+        add_bdf_terms_by_mass_matrix();
+
         virtual void
         assemble_rhs_local_over_cell(const FEValues<dim> &fe_values,
                                      const std::vector<types::global_dof_index> &loc2glb);
@@ -296,6 +756,140 @@ namespace utils::problems {
         virtual void
         solve();
 
+        /**
+         * Solve the linear system matrix * solution = rhs_vector, where
+         * solution is a vector without ghost elements.
+         */
+        virtual void
+        solve_linear_system(LA::MPI::SparseMatrix &matrix,
+                            LA::MPI::Vector &rhs_vector,
+                            LA::MPI::Vector &solution);
+
+        /**
+         * Set the initial guess for the iterative solvers to the extrapolation
+         *   u_e = Σ e_k u^k
+         * of the previous solutions, using extrap_coeffs. For a moving domain
+         * the previous solutions are transferred to the dofs of the current
+         * step through dof_histories; the dofs of cells that were not active
+         * in all the previous steps start from zero. If there are too few
+         * previous solutions, the initial guess is zero.
+         *
+         * @param initial_guess: a vector without ghost elements.
+         */
+        void
+        compute_extrapolated_initial_guess(LA::MPI::Vector &initial_guess);
+
+        /**
+         * Solve the linear system with CG, preconditioned as given by method,
+         * which is either LinearSolver::cg_amg or LinearSolver::cg_jacobi.
+         * The solution vector is used as the initial guess.
+         */
+        void
+        solve_linear_system_cg(LA::MPI::SparseMatrix &matrix,
+                               LA::MPI::Vector &rhs_vector,
+                               LA::MPI::Vector &solution,
+                               LinearSolver method);
+
+        /**
+         * Solve the linear system with a reduced accuracy LU factorization
+         * and iterative refinement, see LinearSolver::direct_refined.
+         */
+        void
+        solve_linear_system_refined(LA::MPI::SparseMatrix &matrix,
+                                    LA::MPI::Vector &rhs_vector,
+                                    LA::MPI::Vector &solution);
+
+        /**
+         * Return true if the preconditioner kept from the previous solves
+         * can't be reused, see set_preconditioner_reuse().
+         */
+        bool
+        preconditioner_needs_setup() const;
+
+        /**
+         * Set up the preconditioner given by linear_solver for the matrix,
+         * and keep it for the next solves.
+         */
+        void
+        setup_preconditioner(const LA::MPI::SparseMatrix &matrix);
+
+        /**
+         * Create the problems of the coarser levels, assemble their
+         * matrices, and set up multigrid_preconditioner with the matrix of
+         * this problem as the finest level, see set_multigrid().
+         */
+        void
+        setup_multigrid(const LA::MPI::SparseMatrix &matrix);
+
+        /**
+         * Make the mesh, the cut space and the matrix of this problem, when
+         * it is a level of the multigrid preconditioner of a finer problem.
+         * The time step and the BDF-coefficients must be set before.
+         *
+         * @param time_loop: assemble the matrix with assemble_matrix() as in
+         * the time loops, else with assemble_system().
+         */
+        void
+        assemble_multigrid_level(double time, bool time_loop);
+
+        /**
+         * Run CG with the given preconditioner.
+         * @param recycle: use deflated_cg, such that the deflation subspace
+         * is used and updated.
+         * @return the number of iterations.
+         */
+        template<typename PreconditionerType>
+        unsigned int
+        run_cg(LA::MPI::SparseMatrix &matrix,
+               LA::MPI::Vector &rhs_vector,
+               LA::MPI::Vector &solution,
+               const PreconditionerType &preconditioner,
+               bool recycle);
+
+        /**
+         * Make the deflation vectors of deflated_cg fit the matrix: for a
+         * moving domain they are transferred from the dofs of the previous
+         * step, else they are removed if the size of the matrix changed.
+         */
+        void
+        prepare_deflation_vectors(const LA::MPI::SparseMatrix &matrix);
+
+        /**
+         * Move a vector (without ghost elements) from the dofs of the previous
+         * time step, dof_histories[1], to the dofs of the current step. The
+         * dofs on cells that were not active in the previous step are set to
+         * zero.
+         */
+        void
+        transfer_from_previous_step(LA::MPI::Vector &vector);
+
+        /**
+         * Compute the L2-projection of the function onto the cut finite
+         * element space of dof_handlers.front(), i.e. find u_h such that
+         *   (u_h, v)_Ω + γ_M g(u_h, v) = (f, v)_Ω,
+         * where g is the ghost penalty, added to each component. The
+         * function must have as many components as the finite element.
+         *
+         * The stabilized mass matrix is well conditioned, so the system is
+         * solved with CG and a Jacobi preconditioner in a number of
+         * iterations that is bounded independently of h. The cost is then
+         * O(n), instead of a factorization of the matrix.
+         *
+         * @param projection: a ghosted vector, e.g. solutions.front().
+         */
+        void
+        project_onto_cut_space(const Function<dim> &function,
+                               LA::MPI::Vector &projection);
+
+        /**
+         * Compute the residual R(u) = Au + N(u) - f of a non-linear problem,
+         * and return its l2-norm. Note that the vector u is also copied to
+         * solutions.front(), since the non-linear terms are evaluated there.
+         */
+        double
+        compute_newton_residual(const LA::MPI::Vector &u,
+                                LA::MPI::Vector &residual);
+
         virtual ErrorBase *
         compute_error(std::shared_ptr<hp::DoFHandler<dim>> &dof_handler,
                       LA::MPI::Vector &solution) = 0;
@@ -334,6 +928,16 @@ namespace utils::problems {
         void
         output_levelset(int time_step) const;
 
+        /**
+         * Write the built patches of data_out in the format set with
+         * set_output_format(): to the files <name>-d<dim>o<order>r<refines>
+         * for vtu, or as a step of the collection name for hdf5.
+         */
+        void
+        write_data_out(const DataOut<dim> &data_out,
+                       const std::string &name,
+                       int time_step) const;
+
         virtual void
         post_processing(unsigned int time_step);
         
@@ -367,6 +971,82 @@ namespace utils::problems {
         // Object managing degrees of freedom for the cutfem method.
         std::deque<std::shared_ptr<hp::DoFHandler<dim>>> dof_handlers;
 
+        // For moving domains: the cell to dof maps of the steps in the
+        // solutions deque, such that dof_histories[k] describes the dofs of
+        // solutions[k]. These are used to evaluate the previous solutions
+        // in the BDF-terms, so in the time loop only the current dof_handler
+        // is kept in dof_handlers.
+        std::deque<DoFHistory<dim>> dof_histories;
+
+        // If true, the previous solutions are extended onto cells that were
+        // not active in the previous steps, see
+        // set_extend_previous_solutions().
+        bool extend_previous_solutions = false;
+
+        // If true, the band of active cells is computed from the local
+        // interface normal velocity, see set_local_active_band().
+        bool local_active_band = false;
+
+        // The method used in solve_linear_system(), see set_linear_solver().
+        LinearSolver linear_solver = LinearSolver::direct;
+        double linear_solver_tolerance = 1e-10;
+
+        // The preconditioner of the iterative solvers, kept between the
+        // solves, see set_preconditioner_reuse(). Only the one given by
+        // linear_solver is set up.
+        std::unique_ptr<LA::MPI::PreconditionAMG> amg_preconditioner;
+        std::unique_ptr<LA::MPI::PreconditionJacobi> jacobi_preconditioner;
+        std::unique_ptr<GeometricMultigrid<dim, LA::MPI::SparseMatrix,
+                LA::MPI::Vector>> multigrid_preconditioner;
+        bool reuse_preconditioner = true;
+        double preconditioner_rebuild_factor = 2;
+        // The number of CG iterations of the first solve after the setup, or
+        // zero if no solve was done yet.
+        unsigned int preconditioner_base_iterations = 0;
+        // Set when the preconditioner should be rebuilt before the next solve.
+        bool preconditioner_outdated = true;
+        // The number of iterations of the last iterative solve, see
+        // get_linear_solver_iterations().
+        unsigned int linear_solver_iterations = 0;
+
+        // The levels of LinearSolver::cg_gmg, see set_multigrid(). The
+        // problems of the coarser levels are kept, since the preconditioner
+        // uses their matrices and dofs.
+        LevelProblemFactory level_problem_factory;
+        unsigned int multigrid_coarse_refines = 0;
+        unsigned int multigrid_smoothing_steps = 2;
+        double multigrid_damping = 0.6;
+        std::vector<std::unique_ptr<CutFEMProblem<dim>>> multigrid_levels;
+        // True in run_time(), such that the levels are assembled with
+        // assemble_matrix().
+        bool in_time_loop = false;
+
+        // If true, the iterative solvers use deflated_cg, see
+        // set_krylov_recycling().
+        bool krylov_recycling = false;
+        DeflatedCG<LA::MPI::Vector> deflated_cg;
+
+        // The parameters of LinearSolver::direct_refined, see
+        // set_refinement_parameters().
+        double low_rank_tolerance = 1e-6;
+        unsigned int max_refinement_steps = 10;
+        std::vector<double> refinement_residuals;
+
+        // See set_snapshot_collector() and set_reduced_basis().
+        ReducedBasis<LA::MPI::Vector> *snapshot_collector = nullptr;
+        const ReducedBasis<LA::MPI::Vector> *reduced_basis = nullptr;
+        double reduced_basis_estimate = 0;
+
+        // The time of step 0 in the time loops, see set_start_time().
+        double start_time = 0;
+
+        // See set_error_file_suffix().
+        std::string error_file_suffix;
+
+        // If true, the first steps are L2-projected instead of interpolated,
+        // see set_project_first_steps().
+        bool project_first_steps = false;
+
         // TODO do we need a deque for each of these too??
         //  - I dont think this can be done. Any processor can only know about
         //    it's own dofs, so if these changed for each time step, we would 
@@ -376,10 +1056,20 @@ namespace utils::problems {
 
         NonMatching::MeshClassifier<dim> cut_mesh_classifier;
 
+        // The faces where the ghost penalty is added. The flags are updated
+        // in initialize_matrices(), after the mesh was reclassified and the
+        // dofs were distributed, and only change in the band of cells swept
+        // by the interface.
+        std::shared_ptr<StabilizedFaces<dim>> stabilized_faces;
+
         LA::MPI::SparseMatrix stiffness_matrix;
         LA::MPI::SparseMatrix timedep_stiffness_matrix;
         LA::MPI::Vector rhs;
 
+        // The mass matrix over the physical domain, only assembled when
+        // bdf_terms_by_mass_matrix is true.
+        LA::MPI::SparseMatrix mass_matrix;
+
         AffineConstraints<double> constraints;
 
         // Queue of current and  previous solutions, used in the time
@@ -421,8 +1111,30 @@ namespace utils::problems {
         // term.
         bool stationary_stiffness_matrix = true;
 
+        // When this flag is set to true, the BDF-terms in the rhs are
+        // computed as a product with mass_matrix for stationary domains, see
+        // set_bdf_terms_by_mass_matrix(). The local rhs assembly methods
+        // should then skip the BDF-terms.
+        bool bdf_terms_by_mass_matrix = false;
+
+        // Acceleration of the fixed point iteration in run_step_non_linear().
+        AndersonAcceleration<LA::MPI::Vector> fixed_point_acceleration;
+
+        // Recycled vectors for the solutions deque and solver temporaries,
+        // to avoid allocating new PETSc vectors in each time step.
+        VectorPool<LA::MPI::Vector> vector_pool;
+
         ConditionalOStream pcout;
         TimerOutput computing_timer;
+        // The section wall times of the last run, see get_timings().
+        std::map<std::string, double> timings;
+
+        // The format of the output, see set_output_format(). The hdf5 file is
+        // created on the first output.
+        OutputFormat output_format = OutputFormat::vtu;
+        bool output_float32 = false;
+        unsigned int output_compression_level = 0;
+        mutable std::unique_ptr<HDF5Output<dim>> hdf5_output;
 
         const unsigned int n_mpi_processes;
         const unsigned int this_mpi_process;
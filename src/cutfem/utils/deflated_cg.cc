@@ -0,0 +1,141 @@
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "deflated_cg.h"
+#include "dense_eigenvalues.h"
+#include "cutfem_problem.h"
+
+
+using namespace dealii;
+
+namespace utils {
+
+    template<typename VectorType>
+    DeflatedCG<VectorType>::
+    DeflatedCG(const unsigned int n_deflation_vectors,
+               const unsigned int n_recycled_directions)
+            : n_deflation_vectors(n_deflation_vectors),
+              n_recycled_directions(n_recycled_directions) {}
+
+
+    template<typename VectorType>
+    void DeflatedCG<VectorType>::
+    clear() {
+        deflation_vectors.clear();
+        deflation_images.clear();
+        directions.clear();
+        direction_images.clear();
+        direction_curvatures.clear();
+    }
+
+
+    template<typename VectorType>
+    void DeflatedCG<VectorType>::
+    set_subspace_size(const unsigned int n_vectors,
+                      const unsigned int n_directions) {
+        n_deflation_vectors = n_vectors;
+        n_recycled_directions = n_directions;
+        if (deflation_vectors.size() > n_deflation_vectors) {
+            deflation_vectors.resize(n_deflation_vectors);
+            deflation_images.resize(n_deflation_vectors);
+        }
+    }
+
+
+    template<typename VectorType>
+    std::vector<VectorType> &DeflatedCG<VectorType>::
+    get_deflation_vectors() {
+        return deflation_vectors;
+    }
+
+
+    template<typename VectorType>
+    void DeflatedCG<VectorType>::
+    deflate(const VectorType &v, VectorType &direction) const {
+        direction = v;
+        for (unsigned int i = 0; i < deflation_vectors.size(); ++i) {
+            direction.add(-(deflation_images[i] * v), deflation_vectors[i]);
+        }
+    }
+
+
+    template<typename VectorType>
+    void DeflatedCG<VectorType>::
+    update_deflation_vectors() {
+        const unsigned int n_old = deflation_vectors.size();
+        const unsigned int n = n_old + directions.size();
+        if (n == 0 || n_deflation_vectors == 0) {
+            return;
+        }
+
+        // The columns of Z = [W, P], their images AZ, and the diagonal of
+        // D = Z^T A Z, which is 1 for the A-orthonormal deflation vectors.
+        std::vector<const VectorType *> basis(n);
+        std::vector<const VectorType *> images(n);
+        std::vector<double> curvatures(n);
+        for (unsigned int j = 0; j < n; ++j) {
+            const bool is_old = j < n_old;
+            basis[j] = is_old ? &deflation_vectors[j] : &directions[j - n_old];
+            images[j] = is_old ? &deflation_images[j]
+                               : &direction_images[j - n_old];
+            curvatures[j] = is_old ? 1 : direction_curvatures[j - n_old];
+        }
+
+        // The Ritz problem D y = θ Z^T Z y is solved as the symmetric
+        // eigenvalue problem H ŷ = (1/θ) ŷ, with H = D^{-1/2} Z^T Z D^{-1/2}
+        // and y = D^{-1/2} ŷ. The smallest Ritz values θ hence correspond to
+        // the largest eigenvalues of H.
+        FullMatrix<double> gram(n, n);
+        for (unsigned int i = 0; i < n; ++i) {
+            for (unsigned int j = 0; j <= i; ++j) {
+                gram(i, j) = (*basis[i] * *basis[j])
+                             / std::sqrt(curvatures[i] * curvatures[j]);
+                gram(j, i) = gram(i, j);
+            }
+        }
+        Vector<double> eigenvalues;
+        FullMatrix<double> eigenvectors;
+        compute_symmetric_eigenpairs(gram, eigenvalues, eigenvectors);
+
+        std::vector<unsigned int> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(),
+                  [&eigenvalues](const unsigned int a, const unsigned int b) {
+                      return eigenvalues(a) > eigenvalues(b);
+                  });
+
+        // Since the ŷ are orthonormal, the new vectors W = Z y are
+        // A-orthonormal.
+        const unsigned int n_new = std::min(n_deflation_vectors, n);
+        std::vector<VectorType> new_vectors(n_new);
+        std::vector<VectorType> new_images(n_new);
+        for (unsigned int l = 0; l < n_new; ++l) {
+            new_vectors[l].reinit(*basis[0], false);
+            new_images[l].reinit(*basis[0], false);
+            for (unsigned int j = 0; j < n; ++j) {
+                const double coefficient = eigenvectors(j, order[l])
+                                           / std::sqrt(curvatures[j]);
+                new_vectors[l].add(coefficient, *basis[j]);
+                new_images[l].add(coefficient, *images[j]);
+            }
+        }
+        deflation_vectors.swap(new_vectors);
+        deflation_images.swap(new_images);
+
+        directions.clear();
+        direction_images.clear();
+        direction_curvatures.clear();
+    }
+
+
+    template
+    class DeflatedCG<Vector<double>>;
+
+    template
+    class DeflatedCG<LA::MPI::Vector>;
+
+} // namespace utils
@@ -0,0 +1,246 @@
+#ifndef MICROBUBBLE_UTILS_DEFLATED_CG_H
+#define MICROBUBBLE_UTILS_DEFLATED_CG_H
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace utils {
+
+    /**
+     * A preconditioned CG method with deflation (Saad et al. 2000), that
+     * recycles the deflation subspace between a sequence of solves with the
+     * same or slowly changing symmetric positive definite matrices, e.g. the
+     * systems of the time steps of a BDF-method.
+     *
+     * Given A-orthonormal deflation vectors W, the search directions are kept
+     * A-orthogonal to W, such that CG only works on the complement of span(W).
+     * If W approximates the eigenvectors of the smallest eigenvalues of A,
+     * e.g. the ones caused by cells with a tiny cut fraction, the effective
+     * condition number is reduced, and so is the number of iterations.
+     *
+     * After each solve, W is replaced by Ritz vectors of A over the span of
+     * the old W and the first search directions of the solve. Since the
+     * directions are A-orthogonal to each other and to W, the projected matrix
+     * Z^T A Z of Z = [W, P] is diagonal, and the Ritz vectors are found from a
+     * small dense eigenvalue problem. The eigenvalue approximations hence
+     * improve over the sequence of solves.
+     *
+     * The matrix may change between the solves: W is A-orthonormalized with
+     * the current matrix at the start of each solve. If the dofs were
+     * renumbered, the vectors returned by get_deflation_vectors() must be
+     * transferred to the new dofs before the next solve.
+     *
+     * @tparam VectorType: a vector without ghost elements.
+     */
+    template<typename VectorType>
+    class DeflatedCG {
+    public:
+        /**
+         * @param n_deflation_vectors: the dimension of the deflation subspace.
+         * @param n_recycled_directions: the number of search directions of
+         * each solve used to update the deflation subspace.
+         */
+        DeflatedCG(unsigned int n_deflation_vectors = 8,
+                   unsigned int n_recycled_directions = 20);
+
+        /**
+         * Remove the deflation subspace, e.g. when the size of the systems
+         * changes.
+         */
+        void
+        clear();
+
+        void
+        set_subspace_size(unsigned int n_deflation_vectors,
+                          unsigned int n_recycled_directions);
+
+        /**
+         * Return the deflation vectors, such that they can be transferred to
+         * new dofs. They are A-orthonormalized again in the next solve.
+         */
+        std::vector<VectorType> &
+        get_deflation_vectors();
+
+        /**
+         * Solve A x = b, with the given value of x as the initial guess.
+         *
+         * @param tolerance: the absolute tolerance of the l2-norm of the
+         * residual. As in SolverControl, the solve has converged when the
+         * norm is less than or equal to the tolerance. For a zero rhs, the
+         * solution is set to zero without iterating.
+         * @return the number of iterations.
+         */
+        template<typename MatrixType, typename PreconditionerType>
+        unsigned int
+        solve(const MatrixType &matrix,
+              VectorType &solution,
+              const VectorType &rhs,
+              const PreconditionerType &preconditioner,
+              double tolerance,
+              unsigned int max_iterations);
+
+    private:
+        /**
+         * A-orthonormalize the deflation vectors with modified Gram-Schmidt,
+         * and compute their images A w. Vectors that are (close to) linearly
+         * dependent on the previous ones are removed.
+         */
+        template<typename MatrixType>
+        void
+        orthonormalize_deflation_vectors(const MatrixType &matrix);
+
+        /**
+         * Subtract W (AW)^T v from the vector, such that it becomes
+         * A-orthogonal to the deflation vectors.
+         */
+        void
+        deflate(const VectorType &v, VectorType &direction) const;
+
+        /**
+         * Replace the deflation vectors with the Ritz vectors of the smallest
+         * Ritz values over span([W, P]), where P are the stored directions.
+         */
+        void
+        update_deflation_vectors();
+
+        unsigned int n_deflation_vectors;
+        unsigned int n_recycled_directions;
+
+        // The A-orthonormal deflation vectors W, and their images AW.
+        std::vector<VectorType> deflation_vectors;
+        std::vector<VectorType> deflation_images;
+
+        // The first search directions p of the last solve, their images Ap,
+        // and p^T A p.
+        std::vector<VectorType> directions;
+        std::vector<VectorType> direction_images;
+        std::vector<double> direction_curvatures;
+    };
+
+
+    template<typename VectorType>
+    template<typename MatrixType, typename PreconditionerType>
+    unsigned int DeflatedCG<VectorType>::
+    solve(const MatrixType &matrix,
+          VectorType &solution,
+          const VectorType &rhs,
+          const PreconditionerType &preconditioner,
+          const double tolerance,
+          const unsigned int max_iterations) {
+        // The solution of a zero rhs is zero, independently of the initial
+        // guess and the tolerance.
+        if (rhs.l2_norm() == 0) {
+            solution = 0;
+            return 0;
+        }
+        orthonormalize_deflation_vectors(matrix);
+        directions.clear();
+        direction_images.clear();
+        direction_curvatures.clear();
+
+        // The residual r = b - Ax of the initial guess.
+        VectorType residual;
+        residual.reinit(rhs, true);
+        matrix.vmult(residual, solution);
+        residual.sadd(-1, 1, rhs);
+
+        // Correct the initial guess in span(W), such that W^T r = 0.
+        for (unsigned int i = 0; i < deflation_vectors.size(); ++i) {
+            const double coefficient = deflation_vectors[i] * residual;
+            solution.add(coefficient, deflation_vectors[i]);
+            residual.add(-coefficient, deflation_images[i]);
+        }
+        if (residual.l2_norm() <= tolerance) {
+            update_deflation_vectors();
+            return 0;
+        }
+
+        VectorType preconditioned;
+        preconditioned.reinit(rhs, true);
+        VectorType direction;
+        direction.reinit(rhs, true);
+        VectorType direction_image;
+        direction_image.reinit(rhs, true);
+
+        preconditioner.vmult(preconditioned, residual);
+        deflate(preconditioned, direction);
+        double residual_dot = residual * preconditioned;
+
+        unsigned int iteration = 0;
+        bool converged = false;
+        while (!converged && iteration < max_iterations) {
+            ++iteration;
+            matrix.vmult(direction_image, direction);
+            const double curvature = direction * direction_image;
+            if (directions.size() < n_recycled_directions) {
+                directions.push_back(direction);
+                direction_images.push_back(direction_image);
+                direction_curvatures.push_back(curvature);
+            }
+
+            const double alpha = residual_dot / curvature;
+            solution.add(alpha, direction);
+            residual.add(-alpha, direction_image);
+            if (residual.l2_norm() <= tolerance) {
+                converged = true;
+                break;
+            }
+
+            preconditioner.vmult(preconditioned, residual);
+            const double next_residual_dot = residual * preconditioned;
+            const double beta = next_residual_dot / residual_dot;
+            residual_dot = next_residual_dot;
+
+            // p = z + βp - W (AW)^T z
+            direction.sadd(beta, 1, preconditioned);
+            for (unsigned int i = 0; i < deflation_vectors.size(); ++i) {
+                direction.add(-(deflation_images[i] * preconditioned),
+                              deflation_vectors[i]);
+            }
+        }
+        if (!converged) {
+            throw std::runtime_error(
+                    "Deflated CG did not converge in "
+                    + std::to_string(max_iterations) + " iterations.");
+        }
+        update_deflation_vectors();
+        return iteration;
+    }
+
+
+    template<typename VectorType>
+    template<typename MatrixType>
+    void DeflatedCG<VectorType>::
+    orthonormalize_deflation_vectors(const MatrixType &matrix) {
+        std::vector<VectorType> vectors;
+        vectors.swap(deflation_vectors);
+        deflation_images.clear();
+
+        VectorType image;
+        for (VectorType &vector : vectors) {
+            image.reinit(vector, true);
+            matrix.vmult(image, vector);
+            const double initial_norm = std::sqrt(vector * image);
+            for (unsigned int j = 0; j < deflation_vectors.size(); ++j) {
+                const double coefficient = deflation_images[j] * vector;
+                vector.add(-coefficient, deflation_vectors[j]);
+                image.add(-coefficient, deflation_images[j]);
+            }
+            const double norm = std::sqrt(std::max(vector * image, 0.));
+            if (norm <= 1e-8 * initial_norm || norm == 0) {
+                continue;
+            }
+            vector /= norm;
+            image /= norm;
+            deflation_vectors.push_back(vector);
+            deflation_images.push_back(image);
+        }
+    }
+
+} // namespace utils
+
+#endif //MICROBUBBLE_UTILS_DEFLATED_CG_H
@@ -0,0 +1,42 @@
+#include <deal.II/lac/lapack_full_matrix.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "dense_eigenvalues.h"
+
+
+namespace utils {
+
+    void
+    compute_symmetric_eigenpairs(const FullMatrix<double> &matrix,
+                                 Vector<double> &eigenvalues,
+                                 FullMatrix<double> &eigenvectors) {
+        const unsigned int n = matrix.m();
+        if (n == 0) {
+            eigenvalues.reinit(0);
+            eigenvectors.reinit(0, 0);
+            return;
+        }
+
+        // All the eigenvalues lie in the Gershgorin bound [-r, r]. LAPACK
+        // only returns the eigenvalues in (lower_bound, upper_bound], so
+        // widen the interval to include all of them.
+        double bound = 0;
+        for (unsigned int i = 0; i < n; ++i) {
+            double row_sum = 0;
+            for (unsigned int j = 0; j < n; ++j) {
+                row_sum += std::abs(matrix(i, j));
+            }
+            bound = std::max(bound, row_sum);
+        }
+        bound = 2 * bound + 1;
+
+        LAPACKFullMatrix<double> lapack_matrix(n);
+        lapack_matrix = matrix;
+        lapack_matrix.set_property(LAPACKSupport::symmetric);
+        lapack_matrix.compute_eigenvalues_symmetric(-bound, bound, 0,
+                                                    eigenvalues, eigenvectors);
+    }
+
+} // namespace utils
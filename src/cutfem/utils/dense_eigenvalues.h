@@ -0,0 +1,30 @@
+#ifndef MICROBUBBLE_UTILS_DENSE_EIGENVALUES_H
+#define MICROBUBBLE_UTILS_DENSE_EIGENVALUES_H
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/vector.h>
+
+
+using namespace dealii;
+
+namespace utils {
+
+    /**
+     * Compute the eigenvalues and eigenvectors of a small symmetric matrix
+     * with LAPACK (dsyevx). This is used for the dense projected problems of
+     * size ~10-100, e.g. in DeflatedCG and ReducedBasis, where the matrix is
+     * the same on all processes, so the result is too.
+     *
+     * @param matrix: the symmetric matrix.
+     * @param eigenvalues: the eigenvalues, in ascending order.
+     * @param eigenvectors: eigenvector i is stored in column i. The
+     * eigenvectors are orthonormal.
+     */
+    void
+    compute_symmetric_eigenpairs(const FullMatrix<double> &matrix,
+                                 Vector<double> &eigenvalues,
+                                 FullMatrix<double> &eigenvectors);
+
+} // namespace utils
+
+#endif //MICROBUBBLE_UTILS_DENSE_EIGENVALUES_H
@@ -0,0 +1,140 @@
+#include <deal.II/fe/fe.h>
+
+#include "dof_history.h"
+
+
+namespace utils {
+
+    template<int dim>
+    DoFHistory<dim>::
+    DoFHistory(const hp::DoFHandler<dim> &dof_handler) {
+        reinit(dof_handler);
+    }
+
+
+    template<int dim>
+    void DoFHistory<dim>::
+    reinit(const hp::DoFHandler<dim> &dof_handler) {
+        const unsigned int n_cells =
+                dof_handler.get_triangulation().n_active_cells();
+        active_fe_indices.assign(n_cells, invalid_fe_index);
+        dof_offsets.assign(n_cells + 1, 0);
+        dof_indices.clear();
+        n_global_dofs = dof_handler.n_dofs();
+
+        // First count the dofs of each cell, to fill the offsets.
+        for (const auto &cell : dof_handler.active_cell_iterators()) {
+            if (cell->is_artificial()) {
+                continue;
+            }
+            const unsigned int index = cell->active_cell_index();
+            active_fe_indices[index] = cell->active_fe_index();
+            dof_offsets[index + 1] = cell->get_fe().n_dofs_per_cell();
+        }
+        for (unsigned int i = 0; i < n_cells; ++i) {
+            dof_offsets[i + 1] += dof_offsets[i];
+        }
+
+        dof_indices.resize(dof_offsets[n_cells]);
+        std::vector<types::global_dof_index> loc2glb;
+        for (const auto &cell : dof_handler.active_cell_iterators()) {
+            if (cell->is_artificial()) {
+                continue;
+            }
+            const unsigned int index = cell->active_cell_index();
+            loc2glb.resize(dof_offsets[index + 1] - dof_offsets[index]);
+            if (loc2glb.empty()) {
+                continue;
+            }
+            cell->get_dof_indices(loc2glb);
+            std::copy(loc2glb.begin(), loc2glb.end(),
+                      dof_indices.begin() + dof_offsets[index]);
+        }
+    }
+
+
+    template<int dim>
+    bool DoFHistory<dim>::
+    has_dofs(const typename Triangulation<dim>::active_cell_iterator &cell) const {
+        const unsigned int index = cell->active_cell_index();
+        return dof_offsets[index + 1] > dof_offsets[index];
+    }
+
+
+    template<int dim>
+    unsigned int DoFHistory<dim>::
+    active_fe_index(const typename Triangulation<dim>::active_cell_iterator &cell) const {
+        return active_fe_indices[cell->active_cell_index()];
+    }
+
+
+    template<int dim>
+    ArrayView<const types::global_dof_index> DoFHistory<dim>::
+    get_dof_indices(const typename Triangulation<dim>::active_cell_iterator &cell) const {
+        const unsigned int index = cell->active_cell_index();
+        return make_array_view(dof_indices.cbegin() + dof_offsets[index],
+                               dof_indices.cbegin() + dof_offsets[index + 1]);
+    }
+
+
+    template<int dim>
+    bool DoFHistory<dim>::
+    find_extension_cell(
+            const typename Triangulation<dim>::active_cell_iterator &cell,
+            typename Triangulation<dim>::active_cell_iterator &extension_cell) const {
+        // First look for a face neighbor with dofs.
+        for (const unsigned int f : cell->face_indices()) {
+            if (neighbor_has_dofs(cell, f)) {
+                extension_cell = cell->neighbor(f);
+                return true;
+            }
+        }
+        // Then look one more cell layer further out.
+        for (const unsigned int f : cell->face_indices()) {
+            if (cell->at_boundary(f) || cell->neighbor(f)->has_children()) {
+                continue;
+            }
+            const typename Triangulation<dim>::active_cell_iterator neighbor =
+                    cell->neighbor(f);
+            if (neighbor->is_artificial()) {
+                continue;
+            }
+            for (const unsigned int g : neighbor->face_indices()) {
+                if (neighbor_has_dofs(neighbor, g)) {
+                    extension_cell = neighbor->neighbor(g);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+
+    template<int dim>
+    bool DoFHistory<dim>::
+    neighbor_has_dofs(
+            const typename Triangulation<dim>::active_cell_iterator &cell,
+            const unsigned int face) const {
+        if (cell->at_boundary(face) || cell->neighbor(face)->has_children()) {
+            return false;
+        }
+        const typename Triangulation<dim>::active_cell_iterator neighbor =
+                cell->neighbor(face);
+        return !neighbor->is_artificial() && has_dofs(neighbor);
+    }
+
+
+    template<int dim>
+    types::global_dof_index DoFHistory<dim>::
+    n_dofs() const {
+        return n_global_dofs;
+    }
+
+
+    template
+    class DoFHistory<2>;
+
+    template
+    class DoFHistory<3>;
+
+} // namespace utils
@@ -0,0 +1,140 @@
+#ifndef MICROBUBBLE_UTILS_DOF_HISTORY_H
+#define MICROBUBBLE_UTILS_DOF_HISTORY_H
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/types.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/hp/dof_handler.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <vector>
+
+
+using namespace dealii;
+
+namespace utils {
+
+    /**
+     * A compact copy of the cell to dof map of a hp::DoFHandler, used to
+     * evaluate the solution of a previous time step on a moving domain.
+     *
+     * For each active cell (indexed by active_cell_index()) the active FE
+     * index and the global dof indices are stored in flat arrays. This is all
+     * that is needed to read out the local dof values of a previous solution
+     * on a cell, so the hp::DoFHandler of that time step does not have to be
+     * kept alive. Since the same FECollection and mapping are used in all the
+     * time steps, the previous solution can then be evaluated with the shape
+     * functions of the FEValues object of the current step, e.g. with
+     * get_function_values_from_local_dof_values(), when the active FE index
+     * of the cell is the same in both steps.
+     *
+     * Only locally owned and ghost cells are stored.
+     *
+     * @tparam dim
+     */
+    template<int dim>
+    class DoFHistory {
+    public:
+        DoFHistory() = default;
+
+        DoFHistory(const hp::DoFHandler<dim> &dof_handler);
+
+        /**
+         * Copy the active FE indices and the dof indices of the cells from
+         * the given dof_handler.
+         */
+        void
+        reinit(const hp::DoFHandler<dim> &dof_handler);
+
+        /**
+         * Return true if the cell is locally owned or a ghost cell, and had
+         * degrees of freedom in the stored step (i.e. it was not FE_Nothing).
+         */
+        bool
+        has_dofs(const typename Triangulation<dim>::active_cell_iterator &cell) const;
+
+        unsigned int
+        active_fe_index(const typename Triangulation<dim>::active_cell_iterator &cell) const;
+
+        /**
+         * Return the global dof indices of the cell in the stored step. The
+         * view is empty if the cell had no degrees of freedom.
+         */
+        ArrayView<const types::global_dof_index>
+        get_dof_indices(const typename Triangulation<dim>::active_cell_iterator &cell) const;
+
+        /**
+         * Find a cell that had degrees of freedom in the stored step, that
+         * the solution can be extended from onto the given cell. A face
+         * neighbor is used if possible, else a face neighbor of a face
+         * neighbor.
+         *
+         * @return false if no such cell was found.
+         */
+        bool
+        find_extension_cell(
+                const typename Triangulation<dim>::active_cell_iterator &cell,
+                typename Triangulation<dim>::active_cell_iterator &extension_cell) const;
+
+        /**
+         * Read out the values of the given vector in the dofs of the cell.
+         * @return false if the cell had no degrees of freedom in the stored
+         * step.
+         */
+        template<typename VectorType>
+        bool
+        get_local_dof_values(
+                const typename Triangulation<dim>::active_cell_iterator &cell,
+                const VectorType &solution,
+                Vector<double> &local_dof_values) const;
+
+        types::global_dof_index
+        n_dofs() const;
+
+    private:
+        /**
+         * Return true if the neighbor of the cell over the given face is an
+         * active cell with degrees of freedom in the stored step.
+         */
+        bool
+        neighbor_has_dofs(
+                const typename Triangulation<dim>::active_cell_iterator &cell,
+                unsigned int face) const;
+
+        // Marks the cells that are artificial on this process.
+        static const unsigned int invalid_fe_index = static_cast<unsigned int>(-1);
+
+        // The active FE index of each active cell.
+        std::vector<unsigned int> active_fe_indices;
+
+        // The dof indices of cell i are found in
+        //   dof_indices[dof_offsets[i]], ..., dof_indices[dof_offsets[i + 1] - 1].
+        std::vector<unsigned int> dof_offsets;
+        std::vector<types::global_dof_index> dof_indices;
+
+        types::global_dof_index n_global_dofs = 0;
+    };
+
+
+    template<int dim>
+    template<typename VectorType>
+    bool DoFHistory<dim>::
+    get_local_dof_values(
+            const typename Triangulation<dim>::active_cell_iterator &cell,
+            const VectorType &solution,
+            Vector<double> &local_dof_values) const {
+        const ArrayView<const types::global_dof_index> indices =
+                get_dof_indices(cell);
+        local_dof_values.reinit(indices.size());
+        for (unsigned int i = 0; i < indices.size(); ++i) {
+            local_dof_values[i] = solution(indices[i]);
+        }
+        return indices.size() > 0;
+    }
+
+} // namespace utils
+
+#endif //MICROBUBBLE_UTILS_DOF_HISTORY_H
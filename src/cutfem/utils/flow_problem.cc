@@ -40,10 +40,11 @@ namespace utils::problems::flow {
                 Function<dim> &analytic_p,
                 const bool stabilized,
                 const bool stationary,
-                const bool compute_error)
+                const bool compute_error,
+                const MPI_Comm &mpi_communicator)
             : CutFEMProblem<dim>(n_refines, element_order, write_output,
                                  levelset_func, stabilized, stationary,
-                                 compute_error),
+                                 compute_error, mpi_communicator),
               mixed_fe(FESystem<dim>(FE_Q<dim>(element_order + 1), dim), 1,
                        FE_Q<dim>(element_order), 1) {
         analytical_velocity = &analytic_v;
@@ -55,17 +56,17 @@ namespace utils::problems::flow {
     void FlowProblem<dim>::
     interpolate_solution(std::shared_ptr<hp::DoFHandler<dim>> &dof_handler,
                          int time_step) {
+        // Use the boundary_values as initial values.
         if (time_step == 0) {
-            // Use the boundary_values as initial values. Interpolate the
-            // boundary_values function into the finite element space.
             boundary_values->set_time(0);
-            Utils::AnalyticalSolutionWrapper<dim> wrapper(*boundary_values,
-                                                          *analytical_pressure);
-            VectorTools::interpolate(*dof_handler, wrapper,
-                                     this->solutions.front());
+        }
+        TensorFunction<1, dim> &velocity =
+                time_step == 0 ? *boundary_values : *analytical_velocity;
+        Utils::AnalyticalSolutionWrapper<dim> wrapper(velocity,
+                                                      *analytical_pressure);
+        if (this->project_first_steps) {
+            this->project_onto_cut_space(wrapper, this->solutions.front());
         } else {
-            Utils::AnalyticalSolutionWrapper<dim> wrapper(*analytical_velocity,
-                                                          *analytical_pressure);
             VectorTools::interpolate(*dof_handler, wrapper,
                                      this->solutions.front());
         }
@@ -93,6 +94,33 @@ namespace utils::problems::flow {
     }
 
 
+    template<int dim>
+    void FlowProblem<dim>::
+    assemble_mass_matrix_local_over_cell(
+            const FEValues<dim> &fe_v,
+            const std::vector<types::global_dof_index> &loc2glb) {
+        const unsigned int dofs_per_cell = fe_v.get_fe().dofs_per_cell;
+        FullMatrix<double> local_matrix(dofs_per_cell, dofs_per_cell);
+
+        const FEValuesExtractors::Vector v(0);
+
+        // Only the velocity block is needed for the BDF-terms.
+        std::vector<Tensor<1, dim>> phi_u(dofs_per_cell);
+        for (unsigned int q = 0; q < fe_v.n_quadrature_points; ++q) {
+            for (const unsigned int k : fe_v.dof_indices()) {
+                phi_u[k] = fe_v[v].value(k, q);
+            }
+            for (const unsigned int i : fe_v.dof_indices()) {
+                for (const unsigned int j : fe_v.dof_indices()) {
+                    local_matrix(i, j) += phi_u[j] * phi_u[i]
+                                          * fe_v.JxW(q); // (u, v)
+                }
+            }
+        }
+        this->mass_matrix.add(loc2glb, local_matrix);
+    }
+
+
     template<int dim>
     void FlowProblem<dim>::
     assemble_rhs_and_bdf_terms_local_over_cell(
@@ -115,7 +143,11 @@ namespace utils::problems::flow {
         std::vector<std::vector<Tensor<1, dim >>> prev_solutions_values(
                 this->solutions.size(), val);
 
-        for (unsigned int k = 0; k < this->solutions.size(); ++k) {
+        // When the BDF-terms are computed with the mass matrix, they are
+        // skipped here.
+        const unsigned int n_bdf_terms =
+                this->bdf_terms_by_mass_matrix ? 1 : this->solutions.size();
+        for (unsigned int k = 1; k < n_bdf_terms; ++k) {
             fe_v[v].get_function_values(this->solutions[k],
                                         prev_solutions_values[k]);
         }
@@ -128,7 +160,7 @@ namespace utils::problems::flow {
         for (unsigned int q = 0; q < fe_v.n_quadrature_points; ++q) {
             // RHS
             prev_values = Tensor<1, dim>();
-            for (unsigned int k = 1; k < this->solutions.size(); ++k) {
+            for (unsigned int k = 1; k < n_bdf_terms; ++k) {
                 prev_values +=
                         this->bdf_coeffs[k] * prev_solutions_values[k][q];
             }
@@ -151,10 +183,6 @@ namespace utils::problems::flow {
             const FEValues<dim> &fe_v,
             const std::vector<types::global_dof_index> &loc2glb) {
 
-        // TODO needed?
-        const hp::FECollection<dim> &fe_collection = this->dof_handlers.front()->get_fe_collection();
-        const hp::QCollection<dim> q_collection(fe_v.get_quadrature());
-
         // Vector for the contribution of each cell
         const unsigned int dofs_per_cell = fe_v.get_fe().dofs_per_cell;
         Vector<double> local_rhs(dofs_per_cell);
@@ -175,39 +203,34 @@ namespace utils::problems::flow {
 
         // The the values of the previous solutions, and insert into the
         // matrix initialized above.
-        const typename Triangulation<dim>::active_cell_iterator &cell =
-                fe_v.get_cell();
-        hp::FEValues<dim> hp_fe_values(this->mapping_collection,
-                                       fe_collection,
-                                       q_collection,
-                                       update_values);
+        Vector<double> local_dof_values;
+        std::unique_ptr<FEValues<dim>> extension_fe_values;
 
         // Read out the solution values from the previous time steps that we
         // need for the BDF-method.
         for (unsigned long k = 1; k < this->solutions.size(); ++k) {
-            typename hp::DoFHandler<dim>::active_cell_iterator cell_prev(
-                    &(this->triangulation), cell->level(), cell->index(),
-                    this->dof_handlers[k].get());
-            const FiniteElement<dim> &fe = cell_prev->get_fe();
-            if (fe.n_dofs_per_cell() == 0) {
+            const FEValues<dim> *fe_values_prev =
+                    this->get_previous_step_fe_values(k, fe_v,
+                                                      local_dof_values,
+                                                      extension_fe_values);
+            if (fe_values_prev == nullptr) {
                 // This means that in the previous solution step, this cell had
                 // FE_Nothing elements. We can therefore not use that cell to
                 // get the values we need for the BDF-formula. If this happens
                 // then the active mesh in the previous step(s) need to be
                 // extended, such that the cells outside the physical domain
-                // can be stabilized. When the aftive mesh is sufficiently
-                // big in all time steps, we should never enter this clause.
-                // If this happens, the values of 0 vill be used.
+                // can be stabilized, or the previous solutions need to be
+                // extended (see set_extend_previous_solutions()). When the
+                // aftive mesh is sufficiently big in all time steps, we should
+                // never enter this clause. If this happens, the values of 0
+                // vill be used.
                 this->pcout << "# NB: need larger cell buffer outside the "
                              "physical domain." << std::endl;
             } else {
                 // Get the function values from the previous time steps.
-                hp_fe_values.reinit(cell_prev);
-                const FEValues<dim> &fe_values_prev = hp_fe_values.get_present_fe_values();
-                fe_values_prev[v].get_function_values(this->solutions[k],
-                                                      prev_solution_values[k]);
+                (*fe_values_prev)[v].get_function_values_from_local_dof_values(
+                        local_dof_values, prev_solution_values[k]);
             }
-
         }
         Tensor<1, dim> phi_u;
         Tensor<1, dim> prev_values;
@@ -494,11 +517,7 @@ namespace utils::problems::flow {
         data_out.add_data_vector(subdomain, "subdomain");
         data_out.build_patches();
 
-        data_out.write_vtu_with_pvtu_record(
-            "", "solution-d" + std::to_string(dim)
-                 + "o" + std::to_string(this->element_order)
-                 + "r" + std::to_string(this->n_refines),
-            time_step, this->mpi_communicator, 2, 8);
+        this->write_data_out(data_out, "solution", time_step);
 
 
         if (!minimal_output) {
@@ -77,7 +77,8 @@ namespace utils::problems::flow {
                     Function<dim> &analytic_p,
                     const bool stabilized = true,
                     const bool stationary = false,
-                    const bool compute_error = true);
+                    const bool compute_error = true,
+                    const MPI_Comm &mpi_communicator = MPI_COMM_WORLD);
 
     protected:
         void
@@ -90,6 +91,11 @@ namespace utils::problems::flow {
         void
         setup_fe_collection() override;
 
+        void
+        assemble_mass_matrix_local_over_cell(
+                const FEValues<dim> &fe_v,
+                const std::vector<types::global_dof_index> &loc2glb) override;
+
         void
         assemble_rhs_and_bdf_terms_local_over_cell(
                 const FEValues<dim> &fe_v,
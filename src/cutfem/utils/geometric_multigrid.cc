@@ -0,0 +1,449 @@
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/fe/fe.h>
+
+#include <deal.II/grid/tria_accessor.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "geometric_multigrid.h"
+#include "cutfem_problem.h"
+
+
+using namespace dealii;
+
+namespace utils {
+
+    namespace {
+
+        // The largest number of dofs on the coarsest level, for which the
+        // dense coarse solver is used.
+        const types::global_dof_index max_coarse_dofs = 20000;
+
+
+        /**
+         * Return the path from the coarse grid to the cell: the index of the
+         * coarse cell, followed by the child index of the cell on each level.
+         * This identifies the same cell in two triangulations made by
+         * refining the same coarse grid.
+         */
+        template<int dim>
+        std::vector<unsigned int>
+        cell_path(typename hp::DoFHandler<dim>::cell_iterator cell) {
+            std::vector<unsigned int> path;
+            while (cell->level() > 0) {
+                const auto parent = cell->parent();
+                unsigned int child = 0;
+                while (parent->child_index(child) != cell->index()) {
+                    ++child;
+                }
+                path.push_back(child);
+                cell = parent;
+            }
+            path.push_back(cell->index());
+            std::reverse(path.begin(), path.end());
+            return path;
+        }
+
+
+        /**
+         * Return the cell with the given path, or end() if it is not refined
+         * that far on this process.
+         */
+        template<int dim>
+        typename hp::DoFHandler<dim>::cell_iterator
+        find_cell(const hp::DoFHandler<dim> &dof_handler,
+                  const std::vector<unsigned int> &path) {
+            auto cell = std::next(dof_handler.begin(0), path[0]);
+            for (unsigned int k = 1; k < path.size(); ++k) {
+                if (!cell->has_children()) {
+                    return dof_handler.end();
+                }
+                cell = cell->child(path[k]);
+            }
+            return cell;
+        }
+
+
+        /**
+         * Get the dofs of the cells with the given paths from the processes
+         * owning them. Every process has to call this function, also when it
+         * has no paths to ask for.
+         */
+        template<int dim>
+        std::map<std::vector<unsigned int>, std::vector<types::global_dof_index>>
+        fetch_remote_cell_dofs(const hp::DoFHandler<dim> &dof_handler,
+                               const std::vector<std::vector<unsigned int>> &paths,
+                               const MPI_Comm &mpi_communicator) {
+            using CellDofs = std::vector<std::pair<std::vector<unsigned int>,
+                    std::vector<types::global_dof_index>>>;
+
+            // The levels are partitioned in almost the same way, so only few
+            // cells are asked for, and the requests can be sent to all the
+            // processes.
+            const std::vector<std::vector<std::vector<unsigned int>>> all_paths =
+                    Utilities::MPI::all_gather(mpi_communicator, paths);
+            const unsigned int this_process =
+                    Utilities::MPI::this_mpi_process(mpi_communicator);
+
+            std::map<unsigned int, CellDofs> answers;
+            std::vector<types::global_dof_index> dofs;
+            for (unsigned int process = 0; process < all_paths.size(); ++process) {
+                if (process == this_process) {
+                    continue;
+                }
+                for (const auto &path : all_paths[process]) {
+                    const auto cell = find_cell(dof_handler, path);
+                    if (cell == dof_handler.end() || !cell->is_active()
+                        || !cell->is_locally_owned()) {
+                        continue;
+                    }
+                    dofs.resize(cell->get_fe().n_dofs_per_cell());
+                    cell->get_dof_indices(dofs);
+                    answers[process].emplace_back(path, dofs);
+                }
+            }
+            const std::map<unsigned int, CellDofs> received =
+                    Utilities::MPI::some_to_some(mpi_communicator, answers);
+
+            std::map<std::vector<unsigned int>,
+                    std::vector<types::global_dof_index>> cell_dofs;
+            for (const auto &answer : received) {
+                cell_dofs.insert(answer.second.begin(), answer.second.end());
+            }
+            if (cell_dofs.size() != paths.size()) {
+                throw std::runtime_error(
+                        "Some parent cells were not found on the coarse level.");
+            }
+            return cell_dofs;
+        }
+
+    } // namespace
+
+
+    template<int dim, typename MatrixType>
+    void
+    make_prolongation_matrix(const hp::DoFHandler<dim> &coarse_dof_handler,
+                             const hp::DoFHandler<dim> &fine_dof_handler,
+                             MatrixType &prolongation,
+                             const MPI_Comm &mpi_communicator) {
+        const IndexSet fine_owned_dofs = fine_dof_handler.locally_owned_dofs();
+        const IndexSet coarse_owned_dofs =
+                coarse_dof_handler.locally_owned_dofs();
+
+        // Find the parent cells that are not owned or ghosts on this process
+        // on the coarse level.
+        std::vector<std::vector<unsigned int>> missing_paths;
+        for (const auto &cell : fine_dof_handler.active_cell_iterators()) {
+            if (!cell->is_locally_owned()
+                || cell->get_fe().n_dofs_per_cell() == 0) {
+                continue;
+            }
+            const std::vector<unsigned int> path =
+                    cell_path<dim>(cell->parent());
+            const auto coarse_cell = find_cell(coarse_dof_handler, path);
+            if (coarse_cell == coarse_dof_handler.end()
+                || !coarse_cell->is_active() || coarse_cell->is_artificial()) {
+                missing_paths.push_back(path);
+            }
+        }
+        std::sort(missing_paths.begin(), missing_paths.end());
+        missing_paths.erase(
+                std::unique(missing_paths.begin(), missing_paths.end()),
+                missing_paths.end());
+        const auto remote_dofs = fetch_remote_cell_dofs(
+                coarse_dof_handler, missing_paths, mpi_communicator);
+
+        // Call add_entry(row, column, value) for each nonzero entry in the
+        // locally owned rows.
+        std::vector<types::global_dof_index> fine_dofs;
+        std::vector<types::global_dof_index> coarse_dofs;
+        const auto for_each_entry = [&](const auto &add_entry) {
+            for (const auto &cell : fine_dof_handler.active_cell_iterators()) {
+                const unsigned int n_dofs = cell->get_fe().n_dofs_per_cell();
+                if (!cell->is_locally_owned() || n_dofs == 0) {
+                    continue;
+                }
+                const auto parent = cell->parent();
+                const std::vector<unsigned int> path = cell_path<dim>(parent);
+                const auto coarse_cell = find_cell(coarse_dof_handler, path);
+                if (coarse_cell != coarse_dof_handler.end()
+                    && coarse_cell->is_active()
+                    && !coarse_cell->is_artificial()) {
+                    coarse_dofs.resize(coarse_cell->get_fe().n_dofs_per_cell());
+                    coarse_cell->get_dof_indices(coarse_dofs);
+                } else {
+                    coarse_dofs = remote_dofs.at(path);
+                }
+                // The parent is outside the active band of the coarse level.
+                if (coarse_dofs.size() != n_dofs) {
+                    continue;
+                }
+
+                fine_dofs.resize(n_dofs);
+                cell->get_dof_indices(fine_dofs);
+                unsigned int child = 0;
+                while (parent->child_index(child) != cell->index()) {
+                    ++child;
+                }
+                const FullMatrix<double> &interpolation =
+                        cell->get_fe().get_prolongation_matrix(
+                                child, RefinementCase<dim>::isotropic_refinement);
+
+                for (unsigned int i = 0; i < n_dofs; ++i) {
+                    if (!fine_owned_dofs.is_element(fine_dofs[i])) {
+                        continue;
+                    }
+                    for (unsigned int j = 0; j < n_dofs; ++j) {
+                        if (interpolation(i, j) != 0) {
+                            add_entry(fine_dofs[i], coarse_dofs[j],
+                                      interpolation(i, j));
+                        }
+                    }
+                }
+            }
+        };
+
+        DynamicSparsityPattern dsp(fine_dof_handler.n_dofs(),
+                                   coarse_dof_handler.n_dofs(),
+                                   fine_owned_dofs);
+        for_each_entry([&dsp](const types::global_dof_index row,
+                              const types::global_dof_index column,
+                              const double) {
+            dsp.add(row, column);
+        });
+        prolongation.reinit(fine_owned_dofs, coarse_owned_dofs, dsp,
+                            mpi_communicator);
+
+        // A fine dof shared by several cells gets the same value from each of
+        // them, so the entries are set and not added.
+        for_each_entry([&prolongation](const types::global_dof_index row,
+                                       const types::global_dof_index column,
+                                       const double value) {
+            prolongation.set(row, column, value);
+        });
+        prolongation.compress(VectorOperation::insert);
+    }
+
+
+    template<int dim, typename MatrixType, typename VectorType>
+    GeometricMultigrid<dim, MatrixType, VectorType>::
+    GeometricMultigrid(const unsigned int smoothing_steps,
+                       const double damping)
+            : smoothing_steps(smoothing_steps), damping(damping),
+              mpi_communicator(MPI_COMM_WORLD) {}
+
+
+    template<int dim, typename MatrixType, typename VectorType>
+    void GeometricMultigrid<dim, MatrixType, VectorType>::
+    initialize(const std::vector<const hp::DoFHandler<dim> *> &dof_handlers,
+               const std::vector<const MatrixType *> &level_matrices,
+               const MPI_Comm &mpi_comm) {
+        if (level_matrices.empty()
+            || dof_handlers.size() != level_matrices.size()) {
+            throw std::invalid_argument(
+                    "GeometricMultigrid needs one matrix for each level.");
+        }
+        clear();
+        mpi_communicator = mpi_comm;
+        matrices = level_matrices;
+
+        const unsigned int n = matrices.size();
+        locally_owned_dofs.resize(n);
+        inverse_diagonals.resize(n);
+        residuals.resize(n);
+        corrections.resize(n);
+        coarse_rhs.resize(n);
+        coarse_solutions.resize(n);
+        for (unsigned int level = 0; level < n; ++level) {
+            locally_owned_dofs[level] = dof_handlers[level]->locally_owned_dofs();
+            const IndexSet &owned = locally_owned_dofs[level];
+
+            inverse_diagonals[level].reinit(owned, mpi_communicator);
+            for (const types::global_dof_index i : owned) {
+                const double diagonal = matrices[level]->diag_element(i);
+                inverse_diagonals[level](i) = diagonal != 0 ? 1 / diagonal : 0;
+            }
+            inverse_diagonals[level].compress(VectorOperation::insert);
+
+            residuals[level].reinit(owned, mpi_communicator);
+            corrections[level].reinit(owned, mpi_communicator);
+            coarse_rhs[level].reinit(owned, mpi_communicator);
+            coarse_solutions[level].reinit(owned, mpi_communicator);
+        }
+
+        for (unsigned int level = 0; level + 1 < n; ++level) {
+            prolongations.push_back(std::make_unique<MatrixType>());
+            make_prolongation_matrix(*dof_handlers[level],
+                                     *dof_handlers[level + 1],
+                                     *prolongations.back(),
+                                     mpi_communicator);
+        }
+        setup_coarse_solver(*matrices[0]);
+    }
+
+
+    template<int dim, typename MatrixType, typename VectorType>
+    void GeometricMultigrid<dim, MatrixType, VectorType>::
+    clear() {
+        matrices.clear();
+        prolongations.clear();
+        locally_owned_dofs.clear();
+        inverse_diagonals.clear();
+        coarse_inverse.reinit(0, 0);
+        residuals.clear();
+        corrections.clear();
+        coarse_rhs.clear();
+        coarse_solutions.clear();
+        local_coarse_values.clear();
+        coarse_values.clear();
+    }
+
+
+    template<int dim, typename MatrixType, typename VectorType>
+    unsigned int GeometricMultigrid<dim, MatrixType, VectorType>::
+    n_levels() const {
+        return matrices.size();
+    }
+
+
+    template<int dim, typename MatrixType, typename VectorType>
+    void GeometricMultigrid<dim, MatrixType, VectorType>::
+    vmult(VectorType &dst, const VectorType &src) const {
+        if (matrices.empty()) {
+            throw std::runtime_error(
+                    "GeometricMultigrid::vmult() called before initialize().");
+        }
+        v_cycle(n_levels() - 1, dst, src);
+    }
+
+
+    template<int dim, typename MatrixType, typename VectorType>
+    void GeometricMultigrid<dim, MatrixType, VectorType>::
+    v_cycle(const unsigned int level,
+            VectorType &solution,
+            const VectorType &rhs) const {
+        if (level == 0) {
+            solve_coarse(solution, rhs);
+            return;
+        }
+        solution = 0;
+        smooth(level, solution, rhs);
+
+        // Restrict the residual, and solve for the correction on the coarser
+        // level, starting from zero.
+        matrices[level]->vmult(residuals[level], solution);
+        residuals[level].sadd(-1, 1, rhs);
+        prolongations[level - 1]->Tvmult(coarse_rhs[level - 1],
+                                         residuals[level]);
+        v_cycle(level - 1, coarse_solutions[level - 1], coarse_rhs[level - 1]);
+        prolongations[level - 1]->vmult(corrections[level],
+                                        coarse_solutions[level - 1]);
+        solution += corrections[level];
+
+        smooth(level, solution, rhs);
+    }
+
+
+    template<int dim, typename MatrixType, typename VectorType>
+    void GeometricMultigrid<dim, MatrixType, VectorType>::
+    smooth(const unsigned int level,
+           VectorType &solution,
+           const VectorType &rhs) const {
+        VectorType &residual = residuals[level];
+        for (unsigned int step = 0; step < smoothing_steps; ++step) {
+            matrices[level]->vmult(residual, solution);
+            residual.sadd(-1, 1, rhs);
+            residual.scale(inverse_diagonals[level]);
+            solution.add(damping, residual);
+        }
+    }
+
+
+    template<int dim, typename MatrixType, typename VectorType>
+    void GeometricMultigrid<dim, MatrixType, VectorType>::
+    setup_coarse_solver(const MatrixType &matrix) {
+        const types::global_dof_index n = matrix.m();
+        if (n > max_coarse_dofs) {
+            throw std::invalid_argument(
+                    "The coarsest multigrid level has " + std::to_string(n)
+                    + " dofs, use a coarser level.");
+        }
+
+        // Sum the locally owned rows over all processes, such that every
+        // process has the full matrix.
+        local_coarse_values.assign(n * n, 0);
+        for (const types::global_dof_index row : locally_owned_dofs[0]) {
+            for (auto entry = matrix.begin(row); entry != matrix.end(row);
+                 ++entry) {
+                local_coarse_values[row * n + entry->column()] = entry->value();
+            }
+        }
+        coarse_values.resize(n * n);
+        Utilities::MPI::sum(local_coarse_values, mpi_communicator,
+                            coarse_values);
+
+        coarse_inverse.reinit(n, n);
+        for (types::global_dof_index i = 0; i < n; ++i) {
+            for (types::global_dof_index j = 0; j < n; ++j) {
+                coarse_inverse(i, j) = coarse_values[i * n + j];
+            }
+        }
+        coarse_inverse.gauss_jordan();
+
+        local_coarse_values.assign(n, 0);
+        coarse_values.assign(n, 0);
+    }
+
+
+    template<int dim, typename MatrixType, typename VectorType>
+    void GeometricMultigrid<dim, MatrixType, VectorType>::
+    solve_coarse(VectorType &solution, const VectorType &rhs) const {
+        const IndexSet &owned = locally_owned_dofs[0];
+        std::fill(local_coarse_values.begin(), local_coarse_values.end(), 0);
+        for (const types::global_dof_index i : owned) {
+            local_coarse_values[i] = rhs(i);
+        }
+        Utilities::MPI::sum(local_coarse_values, mpi_communicator,
+                            coarse_values);
+
+        for (const types::global_dof_index i : owned) {
+            double value = 0;
+            for (unsigned int j = 0; j < coarse_values.size(); ++j) {
+                value += coarse_inverse(i, j) * coarse_values[j];
+            }
+            solution(i) = value;
+        }
+        solution.compress(VectorOperation::insert);
+    }
+
+
+    template
+    class GeometricMultigrid<2, LA::MPI::SparseMatrix, LA::MPI::Vector>;
+
+    template
+    class GeometricMultigrid<3, LA::MPI::SparseMatrix, LA::MPI::Vector>;
+
+    template
+    void
+    make_prolongation_matrix<2, LA::MPI::SparseMatrix>(
+            const hp::DoFHandler<2> &, const hp::DoFHandler<2> &,
+            LA::MPI::SparseMatrix &, const MPI_Comm &);
+
+    template
+    void
+    make_prolongation_matrix<3, LA::MPI::SparseMatrix>(
+            const hp::DoFHandler<3> &, const hp::DoFHandler<3> &,
+            LA::MPI::SparseMatrix &, const MPI_Comm &);
+
+} // namespace utils
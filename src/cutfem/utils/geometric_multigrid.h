@@ -0,0 +1,160 @@
+#ifndef MICROBUBBLE_UTILS_GEOMETRIC_MULTIGRID_H
+#define MICROBUBBLE_UTILS_GEOMETRIC_MULTIGRID_H
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/hp/dof_handler.h>
+
+#include <deal.II/lac/full_matrix.h>
+
+#include <memory>
+#include <vector>
+
+
+using namespace dealii;
+
+namespace utils {
+
+    /**
+     * A geometric multigrid preconditioner for the symmetric positive
+     * definite systems of the cut problems, e.g. the ones of ScalarProblem.
+     *
+     * The levels are the meshes of the global refinements of the same coarse
+     * grid, refine_global(l) for l = l_0, ..., n_refines. Each level has its
+     * own cut space on an hp::DoFHandler (FE_Nothing outside the active
+     * band), and its own matrix, assembled with the Nitsche terms and the
+     * ghost penalty of that level. The level meshes are separate
+     * triangulations, since deal.II has no level dofs for hp::DoFHandler,
+     * so the processes may own different parts of the levels.
+     *
+     * The transfer from level l to l + 1 is the interpolation of the cut
+     * space of level l: the values in the dofs of a fine cell are computed
+     * with the prolongation matrix of the finite element from the dofs of
+     * its parent cell, see make_prolongation_matrix(). The restriction is its
+     * transpose. The fine cells whose parent is outside the active band of
+     * level l get no coarse correction, but are still smoothed.
+     *
+     * vmult() applies one V-cycle, with damped Jacobi smoothing and an exact
+     * solve on the coarsest level. The same number of pre- and
+     * post-smoothing steps is used, so the preconditioner is symmetric, and
+     * can be used with CG.
+     *
+     * The coarsest level is solved with a dense factorization on each
+     * process, so it should only have up to a few thousand dofs.
+     *
+     * @tparam MatrixType: a distributed sparse matrix.
+     * @tparam VectorType: a distributed vector without ghost elements.
+     */
+    template<int dim, typename MatrixType, typename VectorType>
+    class GeometricMultigrid {
+    public:
+        /**
+         * @param smoothing_steps: the number of Jacobi steps before and after
+         * the coarse grid correction on each level.
+         * @param damping: the damping factor ω of the Jacobi steps
+         *   x += ω D^{-1}(b - Ax).
+         */
+        GeometricMultigrid(unsigned int smoothing_steps = 2,
+                           double damping = 0.6);
+
+        /**
+         * Set up the transfers, the smoothers and the coarse solver.
+         *
+         * @param dof_handlers: the dofs of each level, starting with the
+         * coarsest level.
+         * @param matrices: the matrix of each level. The matrix of the
+         * finest level is the one of the system to precondition. The
+         * matrices and the DoFHandlers must be kept alive while the
+         * preconditioner is used.
+         */
+        void
+        initialize(const std::vector<const hp::DoFHandler<dim> *> &dof_handlers,
+                   const std::vector<const MatrixType *> &matrices,
+                   const MPI_Comm &mpi_communicator);
+
+        void
+        clear();
+
+        unsigned int
+        n_levels() const;
+
+        /**
+         * Apply one V-cycle to src, starting from a zero initial guess.
+         */
+        void
+        vmult(VectorType &dst, const VectorType &src) const;
+
+    private:
+        void
+        v_cycle(unsigned int level,
+                VectorType &solution,
+                const VectorType &rhs) const;
+
+        /**
+         * Do the given number of damped Jacobi steps on the level.
+         */
+        void
+        smooth(unsigned int level,
+               VectorType &solution,
+               const VectorType &rhs) const;
+
+        /**
+         * Copy the matrix of the coarsest level to every process, and
+         * factorize it.
+         */
+        void
+        setup_coarse_solver(const MatrixType &matrix);
+
+        void
+        solve_coarse(VectorType &solution, const VectorType &rhs) const;
+
+        const unsigned int smoothing_steps;
+        const double damping;
+        MPI_Comm mpi_communicator;
+
+        std::vector<const MatrixType *> matrices;
+        // prolongations[l] interpolates from level l to level l + 1.
+        std::vector<std::unique_ptr<MatrixType>> prolongations;
+        std::vector<IndexSet> locally_owned_dofs;
+        std::vector<VectorType> inverse_diagonals;
+
+        // The inverse of the matrix of the coarsest level, the same on all
+        // the processes.
+        FullMatrix<double> coarse_inverse;
+
+        // Work vectors of each level. coarse_rhs[l] and coarse_solutions[l]
+        // are the restricted residual and the correction computed on level l
+        // in the V-cycle of level l + 1.
+        mutable std::vector<VectorType> residuals;
+        mutable std::vector<VectorType> corrections;
+        mutable std::vector<VectorType> coarse_rhs;
+        mutable std::vector<VectorType> coarse_solutions;
+        mutable std::vector<double> local_coarse_values;
+        mutable std::vector<double> coarse_values;
+    };
+
+
+    /**
+     * Make the matrix interpolating a function in the cut space of
+     * coarse_dof_handler to the cut space of fine_dof_handler, where the mesh
+     * of fine_dof_handler is the mesh of coarse_dof_handler refined once
+     * more, and both use the same finite elements.
+     *
+     * The two meshes may be partitioned differently. The dofs of the parent
+     * cells that are neither owned nor ghosts on this process are fetched
+     * from the processes owning them.
+     *
+     * @param prolongation: a matrix with the locally owned fine dofs as rows,
+     * and the locally owned coarse dofs as the columns.
+     */
+    template<int dim, typename MatrixType>
+    void
+    make_prolongation_matrix(const hp::DoFHandler<dim> &coarse_dof_handler,
+                             const hp::DoFHandler<dim> &fine_dof_handler,
+                             MatrixType &prolongation,
+                             const MPI_Comm &mpi_communicator);
+
+} // namespace utils
+
+#endif //MICROBUBBLE_UTILS_GEOMETRIC_MULTIGRID_H
@@ -0,0 +1,264 @@
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/geometry_info.h>
+#include <deal.II/base/utilities.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "hdf5_output.h"
+
+
+namespace utils {
+
+    template<int dim>
+    HDF5Output<dim>::
+    HDF5Output(const std::string &basename,
+               const MPI_Comm &mpi_communicator,
+               const bool float32,
+               const unsigned int compression_level)
+            : basename(basename), mpi_communicator(mpi_communicator),
+              float32(float32), compression_level(compression_level) {
+#ifdef DEAL_II_WITH_HDF5
+        if (compression_level > 9) {
+            throw std::invalid_argument(
+                    "The deflate compression level must be in 0-9, got "
+                    + std::to_string(compression_level) + ".");
+        }
+        const hid_t access = H5Pcreate(H5P_FILE_ACCESS);
+#ifdef H5_HAVE_PARALLEL
+        H5Pset_fapl_mpio(access, mpi_communicator, MPI_INFO_NULL);
+#else
+        if (Utilities::MPI::n_mpi_processes(mpi_communicator) > 1) {
+            throw std::runtime_error(
+                    "HDF5 output with more than one process needs HDF5 with "
+                    "parallel support.");
+        }
+#endif
+        file = H5Fcreate((basename + ".h5").c_str(), H5F_ACC_TRUNC,
+                         H5P_DEFAULT, access);
+        H5Pclose(access);
+        if (file < 0) {
+            throw std::runtime_error(
+                    "Could not create the HDF5 file " + basename + ".h5");
+        }
+#else
+        throw std::runtime_error(
+                "HDF5 output needs deal.II configured with HDF5.");
+#endif
+    }
+
+
+    template<int dim>
+    HDF5Output<dim>::
+    ~HDF5Output() {
+#ifdef DEAL_II_WITH_HDF5
+        H5Fclose(file);
+#endif
+    }
+
+
+    template<int dim>
+    void HDF5Output<dim>::
+    write(const DataOut<dim> &data_out,
+          const std::string &collection,
+          const double time) {
+#ifdef DEAL_II_WITH_HDF5
+        // Collect the nodes, cells and data of the patches, with the vector
+        // valued data padded to 3 components, as XDMF needs.
+        DataOutBase::DataOutFilter filter(
+                DataOutBase::DataOutFilterFlags(false, true));
+        data_out.write_filtered_data(filter);
+
+        // The rows of this process start after the ones of the lower ranks.
+        unsigned long long local_sizes[2] = {filter.n_nodes(), filter.n_cells()};
+        unsigned long long offsets[2] = {0, 0};
+        unsigned long long global_sizes[2];
+        MPI_Exscan(local_sizes, offsets, 2, MPI_UNSIGNED_LONG_LONG, MPI_SUM,
+                   mpi_communicator);
+        if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0) {
+            offsets[0] = 0;
+            offsets[1] = 0;
+        }
+        MPI_Allreduce(local_sizes, global_sizes, 2, MPI_UNSIGNED_LONG_LONG,
+                      MPI_SUM, mpi_communicator);
+        const unsigned long long n_nodes = global_sizes[0];
+        const unsigned long long n_cells = global_sizes[1];
+
+        const unsigned int step = xdmf_entries[collection].size();
+        const std::string path = "/" + collection + "/" + std::to_string(step);
+        const hid_t link_creation = H5Pcreate(H5P_LINK_CREATE);
+        H5Pset_create_intermediate_group(link_creation, 1);
+        const hid_t group = H5Gcreate2(file, path.c_str(), link_creation,
+                                       H5P_DEFAULT, H5P_DEFAULT);
+        H5Pclose(link_creation);
+
+        std::vector<double> nodes;
+        filter.fill_node_data(nodes);
+        write_data_set(group, "nodes", nodes, n_nodes, offsets[0], dim,
+                       H5T_NATIVE_DOUBLE, false);
+
+        const unsigned int vertices_per_cell = GeometryInfo<dim>::vertices_per_cell;
+        std::vector<unsigned int> cells;
+        filter.fill_cell_data(offsets[0], cells);
+        write_data_set(group, "cells", cells, n_cells, offsets[1],
+                       vertices_per_cell, H5T_NATIVE_UINT,
+                       compression_level > 0);
+
+        const std::string h5_file =
+                basename.substr(basename.find_last_of('/') + 1) + ".h5";
+        std::ostringstream entry;
+        entry << "      <Grid Name=\"mesh\" GridType=\"Uniform\">\n"
+              << "        <Time Value=\"" << time << "\"/>\n"
+              << "        <Geometry GeometryType=\""
+              << (dim == 2 ? "XY" : "XYZ") << "\">\n"
+              << "          <DataItem Dimensions=\"" << n_nodes << " " << dim
+              << "\" NumberType=\"Float\" Precision=\"8\" Format=\"HDF\">"
+              << h5_file << ":" << path << "/nodes</DataItem>\n"
+              << "        </Geometry>\n"
+              << "        <Topology TopologyType=\""
+              << (dim == 2 ? "Quadrilateral" : "Hexahedron")
+              << "\" NumberOfElements=\"" << n_cells << "\">\n"
+              << "          <DataItem Dimensions=\"" << n_cells << " "
+              << vertices_per_cell
+              << "\" NumberType=\"UInt\" Format=\"HDF\">"
+              << h5_file << ":" << path << "/cells</DataItem>\n"
+              << "        </Topology>\n";
+
+        for (unsigned int i = 0; i < filter.n_data_sets(); ++i) {
+            const std::string name = filter.get_data_set_name(i);
+            const unsigned int n_components = filter.get_data_set_dim(i);
+            const double *data = filter.get_data_set(i);
+            const std::size_t n_values = local_sizes[0] * n_components;
+            if (float32) {
+                const std::vector<float> values(data, data + n_values);
+                write_data_set(group, name, values, n_nodes, offsets[0],
+                               n_components, H5T_NATIVE_FLOAT,
+                               compression_level > 0);
+            } else {
+                const std::vector<double> values(data, data + n_values);
+                write_data_set(group, name, values, n_nodes, offsets[0],
+                               n_components, H5T_NATIVE_DOUBLE,
+                               compression_level > 0);
+            }
+            entry << "        <Attribute Name=\"" << name
+                  << "\" AttributeType=\""
+                  << (n_components == 1 ? "Scalar" : "Vector")
+                  << "\" Center=\"Node\">\n"
+                  << "          <DataItem Dimensions=\"" << n_nodes << " "
+                  << n_components << "\" NumberType=\"Float\" Precision=\""
+                  << (float32 ? 4 : 8) << "\" Format=\"HDF\">"
+                  << h5_file << ":" << path << "/" << name
+                  << "</DataItem>\n"
+                  << "        </Attribute>\n";
+        }
+        entry << "      </Grid>\n";
+        H5Gclose(group);
+        H5Fflush(file, H5F_SCOPE_GLOBAL);
+
+        xdmf_entries[collection].push_back(entry.str());
+        write_xdmf_file();
+#else
+        (void) data_out;
+        (void) collection;
+        (void) time;
+#endif
+    }
+
+
+#ifdef DEAL_II_WITH_HDF5
+    template<int dim>
+    template<typename Number>
+    void HDF5Output<dim>::
+    write_data_set(const hid_t group,
+                   const std::string &name,
+                   const std::vector<Number> &local_data,
+                   const unsigned long long global_rows,
+                   const unsigned long long row_offset,
+                   const unsigned int n_columns,
+                   const hid_t type,
+                   const bool compress) const {
+        const hsize_t global_dims[2] = {global_rows, n_columns};
+        const hsize_t local_rows = local_data.size() / n_columns;
+        const hid_t file_space = H5Screate_simple(2, global_dims, nullptr);
+
+        // Compression needs a chunked layout.
+        const hid_t creation = H5Pcreate(H5P_DATASET_CREATE);
+        if (compress && global_rows > 0) {
+            const hsize_t chunk_dims[2] = {
+                    std::min<hsize_t>(global_rows, 16384), n_columns};
+            H5Pset_chunk(creation, 2, chunk_dims);
+            H5Pset_deflate(creation, compression_level);
+        }
+        const hid_t data_set = H5Dcreate2(group, name.c_str(), type,
+                                          file_space, H5P_DEFAULT, creation,
+                                          H5P_DEFAULT);
+        H5Pclose(creation);
+
+        // Select the rows of this process. All the processes take part in
+        // the collective write, also the ones without any rows.
+        const hsize_t start[2] = {row_offset, 0};
+        const hsize_t count[2] = {local_rows, n_columns};
+        const hsize_t memory_dims[2] = {std::max<hsize_t>(local_rows, 1),
+                                        n_columns};
+        const hid_t memory_space = H5Screate_simple(2, memory_dims, nullptr);
+        if (local_rows > 0) {
+            H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, nullptr,
+                                count, nullptr);
+        } else {
+            H5Sselect_none(file_space);
+            H5Sselect_none(memory_space);
+        }
+
+        const hid_t transfer = H5Pcreate(H5P_DATASET_XFER);
+#ifdef H5_HAVE_PARALLEL
+        H5Pset_dxpl_mpio(transfer, H5FD_MPIO_COLLECTIVE);
+#endif
+        const herr_t status = H5Dwrite(data_set, type, memory_space,
+                                       file_space, transfer,
+                                       local_data.data());
+        H5Pclose(transfer);
+        H5Sclose(memory_space);
+        H5Sclose(file_space);
+        H5Dclose(data_set);
+        if (status < 0) {
+            throw std::runtime_error(
+                    "Could not write the data set " + name + " to "
+                    + basename + ".h5");
+        }
+    }
+#endif
+
+
+    template<int dim>
+    void HDF5Output<dim>::
+    write_xdmf_file() const {
+        if (Utilities::MPI::this_mpi_process(mpi_communicator) != 0) {
+            return;
+        }
+        std::ofstream xdmf(basename + ".xdmf");
+        xdmf << "<?xml version=\"1.0\" ?>\n"
+             << "<!DOCTYPE Xdmf SYSTEM \"Xdmf.dtd\" []>\n"
+             << "<Xdmf Version=\"2.0\">\n"
+             << "  <Domain>\n";
+        for (const auto &collection : xdmf_entries) {
+            xdmf << "    <Grid Name=\"" << collection.first
+                 << "\" GridType=\"Collection\" CollectionType=\"Temporal\">\n";
+            for (const std::string &entry : collection.second) {
+                xdmf << entry;
+            }
+            xdmf << "    </Grid>\n";
+        }
+        xdmf << "  </Domain>\n"
+             << "</Xdmf>\n";
+    }
+
+
+    template
+    class HDF5Output<2>;
+
+    template
+    class HDF5Output<3>;
+
+} // namespace utils
@@ -0,0 +1,118 @@
+#ifndef MICROBUBBLE_UTILS_HDF5_OUTPUT_H
+#define MICROBUBBLE_UTILS_HDF5_OUTPUT_H
+
+#include <deal.II/base/config.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/numerics/data_out.h>
+
+#ifdef DEAL_II_WITH_HDF5
+#include <hdf5.h>
+#endif
+
+#include <map>
+#include <string>
+#include <vector>
+
+
+using namespace dealii;
+
+namespace utils {
+
+    /**
+     * Output of a time series to a single HDF5 file, written with collective
+     * parallel I/O, and an XDMF file describing it, which can be read by
+     * ParaView and VisIt.
+     *
+     * Each call to write() appends the patches of a DataOut object as a new
+     * step to a named collection, e.g. "solution" or "levelset". The
+     * collections are temporal collections in the XDMF file, so several
+     * meshes (e.g. the cut hp-mesh of the solution and the mesh of the level
+     * set) are stored in the same file. The mesh is written in each step,
+     * since the active cells change for a moving domain.
+     *
+     * Compared to one .vtu-file per process and step, the number of files
+     * does not grow with the number of processes and steps. The XDMF file is
+     * rewritten and the HDF5 file is flushed after each step, such that the
+     * output can be read while the program is running.
+     *
+     * The data can be stored as float32 and compressed with deflate (gzip),
+     * which needs HDF5 1.10.2 or newer for parallel writes. The coordinates
+     * of the nodes are always stored in double precision.
+     *
+     * Requires deal.II configured with HDF5 (DEAL_II_WITH_HDF5), with parallel
+     * HDF5 for more than one process.
+     *
+     * @tparam dim
+     */
+    template<int dim>
+    class HDF5Output {
+    public:
+        /**
+         * Create the files <basename>.h5 and <basename>.xdmf. Existing files
+         * are overwritten. This is collective over the communicator.
+         *
+         * @param float32: store the data sets in single precision.
+         * @param compression_level: the deflate level 0-9, where 0 means no
+         * compression.
+         */
+        HDF5Output(const std::string &basename,
+                   const MPI_Comm &mpi_communicator,
+                   bool float32 = false,
+                   unsigned int compression_level = 0);
+
+        /**
+         * Close the HDF5 file. This is collective over the communicator.
+         */
+        ~HDF5Output();
+
+        /**
+         * Append the patches of data_out as a new step of the collection at
+         * the given time. The patches must be built. This is collective over
+         * the communicator.
+         */
+        void
+        write(const DataOut<dim> &data_out,
+              const std::string &collection,
+              double time);
+
+    private:
+#ifdef DEAL_II_WITH_HDF5
+        /**
+         * Write the local rows of a global rows x n_columns data set,
+         * starting at the given row.
+         */
+        template<typename Number>
+        void
+        write_data_set(hid_t group,
+                       const std::string &name,
+                       const std::vector<Number> &local_data,
+                       unsigned long long global_rows,
+                       unsigned long long row_offset,
+                       unsigned int n_columns,
+                       hid_t type,
+                       bool compress) const;
+#endif
+
+        /**
+         * Rewrite the XDMF file from the stored entries, on process 0.
+         */
+        void
+        write_xdmf_file() const;
+
+        const std::string basename;
+        const MPI_Comm mpi_communicator;
+        const bool float32;
+        const unsigned int compression_level;
+
+#ifdef DEAL_II_WITH_HDF5
+        hid_t file;
+#endif
+
+        // The XDMF grid entries of the steps of each collection.
+        std::map<std::string, std::vector<std::string>> xdmf_entries;
+    };
+
+} // namespace utils
+
+#endif //MICROBUBBLE_UTILS_HDF5_OUTPUT_H
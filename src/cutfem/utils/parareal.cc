@@ -0,0 +1,242 @@
+#include <deal.II/base/utilities.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "parareal.h"
+
+
+namespace utils::problems {
+
+    namespace {
+
+        /**
+         * Return the number of steps of length tau in the interval, and
+         * check that it is an integer.
+         */
+        unsigned int
+        n_steps_in(const double length, const double tau) {
+            const double steps = length / tau;
+            if (std::abs(steps - std::round(steps)) > 1e-8 * steps ||
+                std::round(steps) < 1) {
+                throw std::invalid_argument(
+                        "The slice length " + std::to_string(length)
+                        + " is not a multiple of the time step "
+                        + std::to_string(tau) + ".");
+            }
+            return std::round(steps);
+        }
+
+    } // namespace
+
+
+    template<int dim>
+    Parareal<dim>::
+    Parareal(const unsigned int n_slices,
+             const double end_time,
+             const double fine_tau,
+             const double coarse_tau,
+             const ProblemFactory &problem_factory)
+            : n_slices(n_slices),
+              slice_length(end_time / n_slices),
+              fine_steps(n_steps_in(slice_length, fine_tau)),
+              coarse_steps(n_steps_in(slice_length, coarse_tau)),
+              pcout(std::cout,
+                    Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0) {
+        const unsigned int n_processes =
+                Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+        if (n_processes % n_slices != 0) {
+            throw std::invalid_argument(
+                    "The number of MPI processes " + std::to_string(n_processes)
+                    + " is not divisible by the number of time slices "
+                    + std::to_string(n_slices) + ".");
+        }
+        group_size = n_processes / n_slices;
+        const unsigned int rank =
+                Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+        slice = rank / group_size;
+        MPI_Comm_split(MPI_COMM_WORLD, slice, rank, &slice_communicator);
+
+        // The problems of this slice only live on the subcommunicator.
+        fine_problem = problem_factory(fine_tau, slice_communicator);
+        coarse_problem = problem_factory(coarse_tau, slice_communicator);
+
+        fine_problem->set_start_time(slice * slice_length);
+        coarse_problem->set_start_time(slice * slice_length);
+
+        // Rank 0 of each slice writes the errors, so each problem needs its
+        // own file.
+        const std::string slice_suffix = "-slice" + std::to_string(slice);
+        fine_problem->set_error_file_suffix(slice_suffix + "-fine");
+        coarse_problem->set_error_file_suffix(slice_suffix + "-coarse");
+
+        pcout << "Parareal: " << n_slices << " time slices with "
+              << group_size << " MPI rank(s) each, " << fine_steps
+              << " fine and " << coarse_steps << " coarse steps per slice."
+              << std::endl;
+    }
+
+
+    template<int dim>
+    Parareal<dim>::
+    ~Parareal() {
+        // The problems use the subcommunicator, so they are destroyed before
+        // it is freed.
+        fine_problem.reset();
+        coarse_problem.reset();
+        initial_value.clear();
+        coarse_value.clear();
+        fine_value.clear();
+        end_value.clear();
+        MPI_Comm_free(&slice_communicator);
+    }
+
+
+    template<int dim>
+    unsigned int Parareal<dim>::
+    run(const double tol, const unsigned int max_iterations) {
+        // Set up the dofs by interpolating the initial value, such that the
+        // vectors can be created before anything is received.
+        coarse_problem->run_time(1, 0);
+        locally_owned_dofs =
+                coarse_problem->get_dof_handler()->locally_owned_dofs();
+        initial_value.reinit(locally_owned_dofs, slice_communicator);
+        coarse_value.reinit(locally_owned_dofs, slice_communicator);
+        fine_value.reinit(locally_owned_dofs, slice_communicator);
+        end_value.reinit(locally_owned_dofs, slice_communicator);
+
+        // The initial coarse sweep U_{n+1}^0 = G(U_n^0).
+        pcout << "\nParareal: initial coarse sweep" << std::endl;
+        if (slice > 0) {
+            receive_from_previous_slice(initial_value);
+        }
+        propagate(*coarse_problem, coarse_steps, initial_value, coarse_value);
+        end_value = coarse_value;
+        if (slice + 1 < n_slices) {
+            send_to_next_slice(end_value);
+        }
+
+        LA::MPI::Vector new_coarse_value(locally_owned_dofs,
+                                         slice_communicator);
+        LA::MPI::Vector new_end_value(locally_owned_dofs, slice_communicator);
+        unsigned int k = 0;
+        bool converged = false;
+        while (!converged && k < std::min(max_iterations, n_slices)) {
+            k++;
+            pcout << "\nParareal iteration " << k << std::endl;
+
+            // The fine propagators run concurrently in all the slices.
+            fine_error = propagate(*fine_problem, fine_steps, initial_value,
+                                   fine_value);
+
+            // Pass on the corrections from slice to slice.
+            if (slice > 0) {
+                receive_from_previous_slice(initial_value);
+            }
+            propagate(*coarse_problem, coarse_steps, initial_value,
+                      new_coarse_value);
+            new_end_value = new_coarse_value;
+            new_end_value += fine_value;
+            new_end_value -= coarse_value;
+            if (slice + 1 < n_slices) {
+                send_to_next_slice(new_end_value);
+            }
+
+            const double end_norm = new_end_value.l2_norm();
+            end_value -= new_end_value;
+            const double change = end_norm > 0 ? end_value.l2_norm() / end_norm
+                                               : end_value.l2_norm();
+            end_value = new_end_value;
+            coarse_value = new_coarse_value;
+
+            const double max_change =
+                    Utilities::MPI::max(change, MPI_COMM_WORLD);
+            pcout << "Parareal iteration " << k
+                  << ": max relative change of the slice end values = "
+                  << max_change << std::endl;
+            converged = max_change < tol;
+        }
+        return k;
+    }
+
+
+    template<int dim>
+    const LA::MPI::Vector &Parareal<dim>::
+    get_slice_end_solution() const {
+        return end_value;
+    }
+
+
+    template<int dim>
+    ErrorBase *Parareal<dim>::
+    get_fine_error() const {
+        return fine_error;
+    }
+
+
+    template<int dim>
+    CutFEMProblem<dim> &Parareal<dim>::
+    get_fine_problem() {
+        return *fine_problem;
+    }
+
+
+    template<int dim>
+    ErrorBase *Parareal<dim>::
+    propagate(CutFEMProblem<dim> &problem,
+              const unsigned int steps,
+              const LA::MPI::Vector &initial,
+              LA::MPI::Vector &end) {
+        ErrorBase *error;
+        if (slice == 0) {
+            error = problem.run_time(1, steps);
+        } else {
+            // Replace the interpolated u_0 by the initial value.
+            std::vector<LA::MPI::Vector> supplied_solutions(1, initial);
+            error = problem.run_time(1, steps, supplied_solutions);
+        }
+        end = problem.get_solution();
+        return error;
+    }
+
+
+    template<int dim>
+    void Parareal<dim>::
+    send_to_next_slice(const LA::MPI::Vector &vector) const {
+        std::vector<double> values;
+        values.reserve(locally_owned_dofs.n_elements());
+        for (const types::global_dof_index i : locally_owned_dofs) {
+            values.push_back(vector(i));
+        }
+        const int destination =
+                Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) + group_size;
+        MPI_Send(values.data(), values.size(), MPI_DOUBLE, destination, 0,
+                 MPI_COMM_WORLD);
+    }
+
+
+    template<int dim>
+    void Parareal<dim>::
+    receive_from_previous_slice(LA::MPI::Vector &vector) const {
+        std::vector<double> values(locally_owned_dofs.n_elements());
+        const int source =
+                Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) - group_size;
+        MPI_Recv(values.data(), values.size(), MPI_DOUBLE, source, 0,
+                 MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        unsigned int j = 0;
+        for (const types::global_dof_index i : locally_owned_dofs) {
+            vector(i) = values[j++];
+        }
+        vector.compress(VectorOperation::insert);
+    }
+
+
+    template
+    class Parareal<2>;
+
+    template
+    class Parareal<3>;
+
+} // namespace utils::problems
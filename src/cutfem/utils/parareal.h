@@ -0,0 +1,142 @@
+#ifndef MICROBUBBLE_UTILS_PARAREAL_H
+#define MICROBUBBLE_UTILS_PARAREAL_H
+
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/base/mpi.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "cutfem_problem.h"
+
+
+namespace utils::problems {
+
+    using namespace dealii;
+
+    /**
+     * Parareal time parallel integration of a time dependent problem on a
+     * stationary domain, built on CutFEMProblem::run_time().
+     *
+     * The time interval [0, T] is split into N slices of equal length, and
+     * the MPI processes of MPI_COMM_WORLD are split into N groups of equal
+     * size, one for each slice. Each group constructs its own problems on a
+     * subcommunicator: a fine propagator F with the time step fine_tau, and a
+     * coarse propagator G with the larger time step coarse_tau, both using
+     * BDF-1. With U_n the solution at the start of slice n, the iteration is
+     *   U_{n+1}^{k+1} = G(U_n^{k+1}) + F(U_n^k) - G(U_n^k).
+     * The fine propagators of all the slices run concurrently, while the
+     * corrections are passed on from slice to slice. After k iterations, the
+     * first k slices agree with the sequential fine solution.
+     *
+     * The slices are started from the computed solutions with the supplied
+     * solutions of run_time(), and set_start_time(). The values are passed
+     * between the groups process by process, so all the groups must have
+     * the same number of processes, which gives them the same partitioning
+     * of the mesh and the same dofs.
+     *
+     * @tparam dim
+     */
+    template<int dim>
+    class Parareal {
+    public:
+        // Creates the problem of a time slice, with the given time step, on
+        // the given communicator. The problem must use a stationary domain,
+        // and should not write output, since the slices would overwrite each
+        // other's files.
+        using ProblemFactory =
+        std::function<std::unique_ptr<CutFEMProblem<dim>>(
+                double tau, const MPI_Comm &mpi_communicator)>;
+
+        /**
+         * Split MPI_COMM_WORLD into n_slices groups, and construct the fine
+         * and coarse problem of the slice of this process. The length of a
+         * slice, end_time / n_slices, must be a multiple of both fine_tau and
+         * coarse_tau.
+         */
+        Parareal(unsigned int n_slices,
+                 double end_time,
+                 double fine_tau,
+                 double coarse_tau,
+                 const ProblemFactory &problem_factory);
+
+        ~Parareal();
+
+        /**
+         * Run the Parareal iteration, until the largest relative change of
+         * the slice end values is below tol, or at most max_iterations
+         * iterations. The number of iterations never exceeds the number of
+         * slices, since the iteration is exact by then.
+         *
+         * @return the number of iterations.
+         */
+        unsigned int
+        run(double tol, unsigned int max_iterations);
+
+        /**
+         * Return the solution at the end of the time slice of this process.
+         */
+        const LA::MPI::Vector &
+        get_slice_end_solution() const;
+
+        /**
+         * Return the error of the last fine run over the slice of this
+         * process, as computed by run_time().
+         */
+        ErrorBase *
+        get_fine_error() const;
+
+        /**
+         * Return the problem of the fine propagator, e.g. to write the
+         * output of the last fine run.
+         */
+        CutFEMProblem<dim> &
+        get_fine_problem();
+
+    private:
+        /**
+         * Run the problem over the slice from the given initial value. The
+         * first slice starts from the initial value interpolated by the
+         * problem.
+         */
+        ErrorBase *
+        propagate(CutFEMProblem<dim> &problem,
+                  unsigned int steps,
+                  const LA::MPI::Vector &initial_value,
+                  LA::MPI::Vector &end_value);
+
+        void
+        send_to_next_slice(const LA::MPI::Vector &vector) const;
+
+        void
+        receive_from_previous_slice(LA::MPI::Vector &vector) const;
+
+        const unsigned int n_slices;
+        const double slice_length;
+        const unsigned int fine_steps;
+        const unsigned int coarse_steps;
+
+        unsigned int slice;
+        unsigned int group_size;
+        MPI_Comm slice_communicator;
+        ConditionalOStream pcout;
+
+        std::unique_ptr<CutFEMProblem<dim>> fine_problem;
+        std::unique_ptr<CutFEMProblem<dim>> coarse_problem;
+        ErrorBase *fine_error = nullptr;
+
+        // The dofs owned by this process, the same for both problems.
+        IndexSet locally_owned_dofs;
+
+        // The value at the start of the slice, U_n, and the values at the end
+        // of the slice: G(U_n), F(U_n) and the corrected U_{n+1}.
+        LA::MPI::Vector initial_value;
+        LA::MPI::Vector coarse_value;
+        LA::MPI::Vector fine_value;
+        LA::MPI::Vector end_value;
+    };
+
+} // namespace utils::problems
+
+#endif //MICROBUBBLE_UTILS_PARAREAL_H
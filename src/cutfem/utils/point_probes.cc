@@ -0,0 +1,202 @@
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/fe/fe.h>
+
+#include <deal.II/grid/grid_tools.h>
+
+#include <sstream>
+#include <stdexcept>
+
+#include "point_probes.h"
+
+
+namespace utils {
+
+    template<int dim>
+    PointProbes<dim>::
+    PointProbes(const MPI_Comm &mpi_communicator)
+            : mpi_communicator(mpi_communicator) {}
+
+
+    template<int dim>
+    PointProbes<dim>::
+    ~PointProbes() {
+        triangulation_listener.disconnect();
+    }
+
+
+    template<int dim>
+    unsigned int PointProbes<dim>::
+    add_point(const Point<dim> &point) {
+        points.push_back(point);
+        // The new point has not been located yet.
+        cache_is_valid = false;
+        return points.size() - 1;
+    }
+
+
+    template<int dim>
+    void PointProbes<dim>::
+    add_points(const std::vector<Point<dim>> &new_points) {
+        for (const Point<dim> &point : new_points) {
+            add_point(point);
+        }
+    }
+
+
+    template<int dim>
+    unsigned int PointProbes<dim>::
+    n_points() const {
+        return points.size();
+    }
+
+
+    template<int dim>
+    std::vector<Vector<double>> PointProbes<dim>::
+    evaluate(const Mapping<dim> &mapping,
+             const std::shared_ptr<hp::DoFHandler<dim>> &dof_handler,
+             const LA::MPI::Vector &solution) {
+        if (!cache_is_valid_for(dof_handler)) {
+            locate_points(mapping, *dof_handler);
+            cached_dof_handler = dof_handler;
+            cached_n_dofs = dof_handler->n_dofs();
+
+            const Triangulation<dim> &triangulation =
+                    dof_handler->get_triangulation();
+            if (&triangulation != cached_triangulation) {
+                triangulation_listener.disconnect();
+                triangulation_listener = triangulation.signals.any_change
+                        .connect([this]() { cache_is_valid = false; });
+                cached_triangulation = &triangulation;
+            }
+            cache_is_valid = true;
+        }
+
+        // Pack the values of all the probes in one vector, such that they can
+        // be summed over all processes in a single call.
+        std::vector<double> local_values(points.size() * n_components, 0);
+        for (unsigned int i = 0; i < points.size(); ++i) {
+            if (!locally_found[i]) {
+                continue;
+            }
+            for (unsigned int j = 0; j < dof_indices[i].size(); ++j) {
+                const double coefficient = solution(dof_indices[i][j]);
+                for (unsigned int c = 0; c < n_components; ++c) {
+                    local_values[i * n_components + c] +=
+                            coefficient * shape_values[i][j][c];
+                }
+            }
+        }
+        std::vector<double> global_values(local_values.size());
+        Utilities::MPI::sum(local_values, mpi_communicator, global_values);
+
+        std::vector<Vector<double>> values(points.size(),
+                                           Vector<double>(n_components));
+        for (unsigned int i = 0; i < points.size(); ++i) {
+            if (n_owners[i] == 0) {
+                std::ostringstream message;
+                message << "PointProbes: the point " << points[i]
+                        << " is not in the active mesh on any process.";
+                throw std::runtime_error(message.str());
+            }
+            for (unsigned int c = 0; c < n_components; ++c) {
+                values[i][c] = global_values[i * n_components + c]
+                               / n_owners[i];
+            }
+        }
+        return values;
+    }
+
+
+    template<int dim>
+    std::vector<double> PointProbes<dim>::
+    evaluate(const Mapping<dim> &mapping,
+             const std::shared_ptr<hp::DoFHandler<dim>> &dof_handler,
+             const LA::MPI::Vector &solution,
+             const unsigned int component) {
+        const std::vector<Vector<double>> all_values =
+                evaluate(mapping, dof_handler, solution);
+        std::vector<double> values(all_values.size());
+        for (unsigned int i = 0; i < all_values.size(); ++i) {
+            values[i] = all_values[i][component];
+        }
+        return values;
+    }
+
+
+    template<int dim>
+    bool PointProbes<dim>::
+    cache_is_valid_for(
+            const std::shared_ptr<hp::DoFHandler<dim>> &dof_handler) const {
+        // A DoFHandler that is distributed again on the same triangulation is
+        // caught by the number of dofs, and a refinement of the triangulation
+        // by the listener, which resets cache_is_valid. Both are the same on
+        // all processes, so all of them search for the points together.
+        return cache_is_valid
+               && cached_dof_handler.lock() == dof_handler
+               && cached_n_dofs == dof_handler->n_dofs()
+               && cached_triangulation == &dof_handler->get_triangulation();
+    }
+
+
+    template<int dim>
+    void PointProbes<dim>::
+    locate_points(const Mapping<dim> &mapping,
+                  const hp::DoFHandler<dim> &dof_handler) {
+        n_components = dof_handler.get_fe_collection().n_components();
+
+        locally_found.assign(points.size(), false);
+        dof_indices.assign(points.size(), {});
+        shape_values.assign(points.size(), {});
+        std::vector<double> local_owners(points.size(), 0);
+
+        for (unsigned int i = 0; i < points.size(); ++i) {
+            std::pair<typename hp::DoFHandler<dim>::active_cell_iterator,
+                    Point<dim>> cell_and_point;
+            try {
+                cell_and_point = GridTools::find_active_cell_around_point(
+                        mapping, dof_handler, points[i]);
+            } catch (const std::exception &) {
+                // The point is not in the part of the mesh known to this
+                // process.
+                continue;
+            }
+            const auto &cell = cell_and_point.first;
+            const Point<dim> &unit_point = cell_and_point.second;
+
+            if (!cell->is_locally_owned()) {
+                continue;
+            }
+            const FiniteElement<dim> &fe = cell->get_fe();
+            if (fe.n_dofs_per_cell() == 0) {
+                // The cell has FE_Nothing elements, so the solution is zero.
+                continue;
+            }
+
+            locally_found[i] = true;
+            local_owners[i] = 1;
+
+            dof_indices[i].resize(fe.n_dofs_per_cell());
+            cell->get_dof_indices(dof_indices[i]);
+
+            shape_values[i].resize(fe.n_dofs_per_cell(),
+                                   std::vector<double>(n_components, 0));
+            for (unsigned int j = 0; j < fe.n_dofs_per_cell(); ++j) {
+                for (unsigned int c = 0; c < n_components; ++c) {
+                    shape_values[i][j][c] =
+                            fe.shape_value_component(j, unit_point, c);
+                }
+            }
+        }
+        n_owners.resize(points.size());
+        Utilities::MPI::sum(local_owners, mpi_communicator, n_owners);
+    }
+
+
+    template
+    class PointProbes<2>;
+
+    template
+    class PointProbes<3>;
+
+} // namespace utils
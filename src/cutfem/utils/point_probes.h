@@ -0,0 +1,146 @@
+#ifndef MICROBUBBLE_UTILS_POINT_PROBES_H
+#define MICROBUBBLE_UTILS_POINT_PROBES_H
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/point.h>
+
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/hp/dof_handler.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <boost/signals2/connection.hpp>
+
+#include <memory>
+#include <vector>
+
+#include "cutfem_problem.h"
+
+
+using namespace dealii;
+
+namespace utils {
+
+    /**
+     * Class for evaluating a finite element solution in a set of fixed points
+     * (probes), e.g. the points a_1 and a_2 in the DFG benchmarks.
+     *
+     * The points are registered once. The cell containing each point, and the
+     * values of the shape functions in the point, are then cached the first
+     * time the probes are evaluated with a given DoFHandler. The cell search
+     * is only done again when the probes are evaluated with a different
+     * DoFHandler (e.g. for a moving domain, where a new DoFHandler is created
+     * in each time step), when the number of dofs of the DoFHandler has
+     * changed, or when its triangulation has been changed (e.g. refined)
+     * since the last search. Each point is only evaluated on the process
+     * owning the cell that contains it, and the values are then summed over
+     * all processes, so every process receives the values of all the probes.
+     *
+     * @tparam dim
+     */
+    template<int dim>
+    class PointProbes {
+    public:
+        PointProbes(const MPI_Comm &mpi_communicator);
+
+        // The listener on the triangulation refers to this object.
+        PointProbes(const PointProbes &) = delete;
+
+        PointProbes &
+        operator=(const PointProbes &) = delete;
+
+        ~PointProbes();
+
+        /**
+         * Register a point to evaluate the solution in.
+         * @return the index of the probe.
+         */
+        unsigned int
+        add_point(const Point<dim> &point);
+
+        void
+        add_points(const std::vector<Point<dim>> &points);
+
+        unsigned int
+        n_points() const;
+
+        /**
+         * Evaluate all components of the solution in all the registered points.
+         * The cell search is only performed if the dof_handler, its number of
+         * dofs or its triangulation has changed since the last call.
+         *
+         * @return a vector of length n_points(), where each entry holds the
+         * value of all the components in that point.
+         * @throws std::runtime_error if a point is not in a cell of the active
+         * mesh on any process, i.e. if it is outside the mesh or in a cell
+         * with FE_Nothing elements.
+         */
+        std::vector<Vector<double>>
+        evaluate(const Mapping<dim> &mapping,
+                 const std::shared_ptr<hp::DoFHandler<dim>> &dof_handler,
+                 const LA::MPI::Vector &solution);
+
+        /**
+         * Evaluate a single component of the solution in all the registered
+         * points.
+         */
+        std::vector<double>
+        evaluate(const Mapping<dim> &mapping,
+                 const std::shared_ptr<hp::DoFHandler<dim>> &dof_handler,
+                 const LA::MPI::Vector &solution,
+                 unsigned int component);
+
+    private:
+        /**
+         * Find the locally owned cells containing the points, and compute the
+         * shape function values in the points.
+         */
+        void
+        locate_points(const Mapping<dim> &mapping,
+                      const hp::DoFHandler<dim> &dof_handler);
+
+        /**
+         * Return true if the cached cells and shape values were computed for
+         * this dof_handler, in its current state.
+         */
+        bool
+        cache_is_valid_for(
+                const std::shared_ptr<hp::DoFHandler<dim>> &dof_handler) const;
+
+        MPI_Comm mpi_communicator;
+
+        std::vector<Point<dim>> points;
+
+        // The DoFHandler the cached data below was computed for, and its
+        // number of dofs and triangulation at that time.
+        std::weak_ptr<hp::DoFHandler<dim>> cached_dof_handler;
+        types::global_dof_index cached_n_dofs = 0;
+        const Triangulation<dim> *cached_triangulation = nullptr;
+        bool cache_is_valid = false;
+
+        // Invalidates the cache when the cached triangulation is changed.
+        boost::signals2::connection triangulation_listener;
+
+        unsigned int n_components = 0;
+
+        // For each point: true if it is located in a cell owned by this
+        // process.
+        std::vector<bool> locally_found;
+
+        // The global dof indices of the cell containing each point.
+        std::vector<std::vector<types::global_dof_index>> dof_indices;
+
+        // shape_values[i][j][c]: the c-th component of the j-th shape
+        // function of the cell containing point i, evaluated in that point.
+        std::vector<std::vector<std::vector<double>>> shape_values;
+
+        // The number of processes each point was found on. A point on the
+        // boundary between two cells owned by different processes is found on
+        // both of them.
+        std::vector<double> n_owners;
+    };
+
+} // namespace utils
+
+#endif //MICROBUBBLE_UTILS_POINT_PROBES_H
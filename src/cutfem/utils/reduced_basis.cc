@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#include "reduced_basis.h"
+#include "dense_eigenvalues.h"
+#include "cutfem_problem.h"
+
+
+using namespace dealii;
+
+namespace utils {
+
+    template<typename VectorType>
+    ReducedBasis<VectorType>::
+    ReducedBasis(const double energy_tolerance, const unsigned int max_size)
+            : energy_tolerance(energy_tolerance), max_size(max_size) {}
+
+
+    template<typename VectorType>
+    void ReducedBasis<VectorType>::
+    clear() {
+        snapshots.clear();
+        basis.clear();
+        truncation_error = 0;
+    }
+
+
+    template<typename VectorType>
+    void ReducedBasis<VectorType>::
+    add_snapshot(const VectorType &snapshot) {
+        if (!snapshots.empty() && snapshot.size() != snapshots[0].size()) {
+            throw std::invalid_argument(
+                    "The snapshot has " + std::to_string(snapshot.size())
+                    + " dofs, but the previous snapshots have "
+                    + std::to_string(snapshots[0].size())
+                    + ". All the snapshots must use the same dofs.");
+        }
+        snapshots.emplace_back();
+        snapshots.back().reinit(snapshot, true);
+        snapshots.back() = snapshot;
+    }
+
+
+    template<typename VectorType>
+    unsigned int ReducedBasis<VectorType>::
+    n_snapshots() const {
+        return snapshots.size();
+    }
+
+
+    template<typename VectorType>
+    unsigned int ReducedBasis<VectorType>::
+    compute_basis() {
+        basis.clear();
+        const unsigned int m = snapshots.size();
+        if (m == 0) {
+            truncation_error = 0;
+            return 0;
+        }
+
+        // The correlation matrix C_ij = (s_i, s_j).
+        FullMatrix<double> correlation(m, m);
+        for (unsigned int i = 0; i < m; ++i) {
+            for (unsigned int j = 0; j <= i; ++j) {
+                correlation(i, j) = snapshots[i] * snapshots[j];
+                correlation(j, i) = correlation(i, j);
+            }
+        }
+        Vector<double> eigenvalues;
+        FullMatrix<double> eigenvectors;
+        compute_symmetric_eigenpairs(correlation, eigenvalues, eigenvectors);
+
+        std::vector<unsigned int> order(m);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(),
+                  [&eigenvalues](const unsigned int a, const unsigned int b) {
+                      return eigenvalues(a) > eigenvalues(b);
+                  });
+
+        double total_energy = 0;
+        for (unsigned int i = 0; i < m; ++i) {
+            total_energy += std::max(eigenvalues(i), 0.);
+        }
+        if (total_energy == 0) {
+            truncation_error = 0;
+            return 0;
+        }
+
+        // Add modes until the discarded energy is below the tolerance. Modes
+        // with eigenvalues at round-off level are never used, since they
+        // can't be normalized accurately.
+        double discarded_energy = total_energy;
+        for (unsigned int l = 0; l < std::min(m, max_size); ++l) {
+            const double eigenvalue = eigenvalues(order[l]);
+            if (discarded_energy <= energy_tolerance * total_energy ||
+                eigenvalue <= 1e-14 * eigenvalues(order[0])) {
+                break;
+            }
+            basis.emplace_back();
+            basis.back().reinit(snapshots[0], false);
+            for (unsigned int j = 0; j < m; ++j) {
+                basis.back().add(eigenvectors(j, order[l]), snapshots[j]);
+            }
+            basis.back() /= std::sqrt(eigenvalue);
+            discarded_energy -= eigenvalue;
+        }
+        truncation_error = std::max(discarded_energy, 0.) / total_energy;
+        return basis.size();
+    }
+
+
+    template<typename VectorType>
+    unsigned int ReducedBasis<VectorType>::
+    size() const {
+        return basis.size();
+    }
+
+
+    template<typename VectorType>
+    double ReducedBasis<VectorType>::
+    get_truncation_error() const {
+        return truncation_error;
+    }
+
+
+    template
+    class ReducedBasis<Vector<double>>;
+
+    template
+    class ReducedBasis<LA::MPI::Vector>;
+
+} // namespace utils
@@ -0,0 +1,157 @@
+#ifndef MICROBUBBLE_UTILS_REDUCED_BASIS_H
+#define MICROBUBBLE_UTILS_REDUCED_BASIS_H
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <vector>
+
+
+using namespace dealii;
+
+namespace utils {
+
+    /**
+     * A POD (proper orthogonal decomposition) reduced basis, used as a
+     * reduced solver in studies where the same kind of problem is solved
+     * for many values of some parameters, e.g. the viscosity or the boundary
+     * data.
+     *
+     * Snapshots of full order solutions are collected with add_snapshot(),
+     * and the basis is computed with compute_basis(). Then an assembled full
+     * order system Au = b for a new parameter is solved in the span of the
+     * basis Φ with solve(), by the Galerkin projection
+     *   Φ^T A Φ y = Φ^T b,   u = Φ y.
+     * The reduced system is only of the size of the basis, so it is solved
+     * directly on each process.
+     *
+     * Note that this is only a reduced solver, and not a reduced-order model
+     * with an offline/online split: there is no affine decomposition of the
+     * operators, so Φ^T A Φ is computed from the full order matrix in each
+     * solve. The full order system is still assembled for each parameter,
+     * and a solve costs O(nN) for n basis vectors and N dofs. Only the
+     * factorization (or the iterative solve) of the full order system is
+     * saved.
+     *
+     * The basis is computed with the method of snapshots: the eigenvectors
+     * v_i of the correlation matrix C_ij = (s_i, s_j) give the basis vectors
+     * φ_i = S v_i / sqrt(λ_i). Only dot products of distributed vectors are
+     * needed, so this works in parallel without assembling the snapshot
+     * matrix S on one process.
+     *
+     * All the snapshots and the systems solved must have the same dofs and
+     * the same parallel layout. For the cut problems, this means that the
+     * domain (and hence the active mesh) must be the same in all the runs.
+     *
+     * @tparam VectorType: a vector without ghost elements.
+     */
+    template<typename VectorType>
+    class ReducedBasis {
+    public:
+        /**
+         * @param energy_tolerance: the basis is truncated when the relative
+         * POD energy Σ_{i > n} λ_i / Σ_i λ_i of the discarded modes is below
+         * this tolerance.
+         * @param max_size: the maximal number of basis vectors.
+         */
+        ReducedBasis(double energy_tolerance = 1e-8,
+                     unsigned int max_size = 50);
+
+        /**
+         * Remove the snapshots and the basis.
+         */
+        void
+        clear();
+
+        void
+        add_snapshot(const VectorType &snapshot);
+
+        unsigned int
+        n_snapshots() const;
+
+        /**
+         * Compute the POD basis from the snapshots added so far. The
+         * snapshots are kept, so more snapshots can be added and the basis
+         * recomputed.
+         *
+         * @return the number of basis vectors.
+         */
+        unsigned int
+        compute_basis();
+
+        unsigned int
+        size() const;
+
+        /**
+         * Return the relative POD energy of the discarded modes in the last
+         * call to compute_basis(). This is the relative mean squared
+         * projection error of the snapshots onto the basis.
+         */
+        double
+        get_truncation_error() const;
+
+        /**
+         * Solve the system Au = b in the span of the basis.
+         *
+         * @return the relative residual ||b - Au|| / ||b|| of the reduced
+         * solution, used as an error estimate. If it is large, the basis does
+         * not represent the solutions for this parameter, and more snapshots
+         * are needed.
+         */
+        template<typename MatrixType>
+        double
+        solve(const MatrixType &matrix,
+              VectorType &solution,
+              const VectorType &rhs) const;
+
+    private:
+        double energy_tolerance;
+        unsigned int max_size;
+        double truncation_error = 0;
+
+        std::vector<VectorType> snapshots;
+        std::vector<VectorType> basis;
+    };
+
+
+    template<typename VectorType>
+    template<typename MatrixType>
+    double ReducedBasis<VectorType>::
+    solve(const MatrixType &matrix,
+          VectorType &solution,
+          const VectorType &rhs) const {
+        const unsigned int n = basis.size();
+
+        // Assemble the reduced matrix Φ^T A Φ and rhs Φ^T b.
+        FullMatrix<double> reduced_matrix(n, n);
+        Vector<double> reduced_rhs(n);
+        VectorType image;
+        image.reinit(rhs, true);
+        for (unsigned int j = 0; j < n; ++j) {
+            matrix.vmult(image, basis[j]);
+            for (unsigned int i = 0; i < n; ++i) {
+                reduced_matrix(i, j) = basis[i] * image;
+            }
+            reduced_rhs(j) = basis[j] * rhs;
+        }
+
+        Vector<double> coefficients(n);
+        if (n > 0) {
+            reduced_matrix.gauss_jordan();
+            reduced_matrix.vmult(coefficients, reduced_rhs);
+        }
+        solution = 0;
+        for (unsigned int i = 0; i < n; ++i) {
+            solution.add(coefficients(i), basis[i]);
+        }
+
+        // The residual b - Au of the reduced solution.
+        matrix.vmult(image, solution);
+        image.sadd(-1, 1, rhs);
+        const double rhs_norm = rhs.l2_norm();
+        return rhs_norm > 0 ? image.l2_norm() / rhs_norm : image.l2_norm();
+    }
+
+} // namespace utils
+
+#endif //MICROBUBBLE_UTILS_REDUCED_BASIS_H
@@ -39,11 +39,17 @@ namespace utils::problems::scalar {
                                       Function<dim> &analytical_soln,
                                       const bool stabilized,
                                       const bool stationary,
-                                      const bool compute_error)
+                                      const bool compute_error,
+                                      const MPI_Comm &mpi_communicator)
             : CutFEMProblem<dim>(n_refines, element_order, write_output,
                                  levelset_func, stabilized, stationary,
-                                 compute_error), fe(element_order) {
+                                 compute_error, mpi_communicator),
+              fe(element_order) {
         analytical_solution = &analytical_soln;
+        // The symmetric Nitsche terms and the ghost penalty give a symmetric
+        // positive definite matrix, so the LDL^T factorization is used by
+        // default. Use set_linear_solver() to solve with CG instead.
+        this->linear_solver = LinearSolver::direct_symmetric;
     }
 
 
@@ -59,15 +65,13 @@ namespace utils::problems::scalar {
         interpolated.reinit(this->locally_owned_dofs, 
                             this->locally_relevant_dofs, 
                             this->mpi_communicator);
-        if (time_step == 0) {
-
-            VectorTools::interpolate(*dof_handler,
-                                     *(this->boundary_values),
-                                     interpolated);
+        const Function<dim> &function = time_step == 0
+                                        ? *(this->boundary_values)
+                                        : *(this->analytical_solution);
+        if (this->project_first_steps) {
+            this->project_onto_cut_space(function, interpolated);
         } else {
-            VectorTools::interpolate(*dof_handler,
-                                     *(this->analytical_solution),
-                                     interpolated);
+            VectorTools::interpolate(*dof_handler, function, interpolated);
         }
         this->solutions.front() = interpolated;
     }
@@ -102,10 +106,8 @@ namespace utils::problems::scalar {
                                        this->cut_mesh_classifier,
                                        this->constraints);
         
-        std::shared_ptr<utils::Selector<dim>> face_selector(
-                new Selector<dim>(this->cut_mesh_classifier));
         if (this->stabilized) {
-            velocity_stab.set_faces_to_stabilize(face_selector);
+            velocity_stab.set_faces_to_stabilize(this->stabilized_faces);
             velocity_stab.set_weight_function(stabilization::taylor_weights);
             velocity_stab.set_extractor(velocities);
         }
@@ -184,6 +186,27 @@ namespace utils::problems::scalar {
     }
 
 
+    template<int dim>
+    void ScalarProblem<dim>::
+    assemble_mass_matrix_local_over_cell(
+            const FEValues<dim> &fe_values,
+            const std::vector<types::global_dof_index> &loc2glb) {
+        const unsigned int dofs_per_cell = fe_values.get_fe().dofs_per_cell;
+        FullMatrix<double> local_matrix(dofs_per_cell, dofs_per_cell);
+
+        for (unsigned int q = 0; q < fe_values.n_quadrature_points; ++q) {
+            for (const unsigned int i : fe_values.dof_indices()) {
+                for (const unsigned int j : fe_values.dof_indices()) {
+                    local_matrix(i, j) += fe_values.shape_value(j, q)
+                                          * fe_values.shape_value(i, q)
+                                          * fe_values.JxW(q); // (u, v)
+                }
+            }
+        }
+        this->mass_matrix.add(loc2glb, local_matrix);
+    }
+
+
     template<int dim>
     void ScalarProblem<dim>::
     assemble_rhs_and_bdf_terms_local_over_cell(
@@ -204,8 +227,11 @@ namespace utils::problems::scalar {
                 this->solutions.size(), val);
 
         // The the values of the previous solutions, and insert into the
-        // matrix initialized above.
-        for (unsigned long k = 1; k < this->solutions.size(); ++k) {
+        // matrix initialized above. When the BDF-terms are computed with the
+        // mass matrix, they are skipped here.
+        const unsigned long n_bdf_terms =
+                this->bdf_terms_by_mass_matrix ? 1 : this->solutions.size();
+        for (unsigned long k = 1; k < n_bdf_terms; ++k) {
             fe_values.get_function_values(this->solutions[k],
                                           prev_solution_values[k]);
         }
@@ -213,7 +239,7 @@ namespace utils::problems::scalar {
         double prev_values;
         for (unsigned int q = 0; q < fe_values.n_quadrature_points; ++q) {
             prev_values = 0;
-            for (unsigned long k = 1; k < this->solutions.size(); ++k) {
+            for (unsigned long k = 1; k < n_bdf_terms; ++k) {
                 prev_values +=
                         this->bdf_coeffs[k] * prev_solution_values[k][q];
             }
@@ -235,10 +261,6 @@ namespace utils::problems::scalar {
             const FEValues<dim> &fe_values,
             const std::vector<types::global_dof_index> &loc2glb) {
 
-        // TODO needed?
-        const hp::FECollection<dim> &fe_collection = this->dof_handlers.front()->get_fe_collection();
-        const hp::QCollection<dim> q_collection(fe_values.get_quadrature());
-
         // Vector for the contribution of each cell
         const unsigned int dofs_per_cell = fe_values.get_fe().dofs_per_cell;
         Vector<double> local_rhs(dofs_per_cell);
@@ -255,38 +277,34 @@ namespace utils::problems::scalar {
 
         // The the values of the previous solutions, and insert into the
         // matrix initialized above.
-        const typename Triangulation<dim>::active_cell_iterator &cell =
-                fe_values.get_cell();
-        hp::FEValues<dim> hp_fe_values(this->mapping_collection,
-                                       fe_collection,
-                                       q_collection,
-                                       update_values);
+        const FEValuesExtractors::Scalar u(0);
+        Vector<double> local_dof_values;
+        std::unique_ptr<FEValues<dim>> extension_fe_values;
 
         // Read out the solution values from the previous time steps that we
         // need for the BDF-method.
         for (unsigned long k = 1; k < this->solutions.size(); ++k) {
-            typename hp::DoFHandler<dim>::active_cell_iterator cell_prev(
-                    &(this->triangulation), cell->level(), cell->index(),
-                    this->dof_handlers[k].get());
-            const FiniteElement<dim> &fe = cell_prev->get_fe();
-            if (fe.n_dofs_per_cell() == 0) {
+            const FEValues<dim> *fe_values_prev =
+                    this->get_previous_step_fe_values(k, fe_values,
+                                                      local_dof_values,
+                                                      extension_fe_values);
+            if (fe_values_prev == nullptr) {
                 // This means that in the previous solution step, this cell had
                 // FE_Nothing elements. We can therefore not use that cell to
                 // get the values we need for the BDF-formula. If this happens
                 // then the active mesh in the previous step(s) need to be
                 // extended, such that the cells outside the physical domain
-                // can be stabilized. When the aftive mesh is sufficiently
-                // big in all time steps, we should never enter this clause.
-                // If this happens, the values of 0 vill be used.
+                // can be stabilized, or the previous solutions need to be
+                // extended (see set_extend_previous_solutions()). When the
+                // aftive mesh is sufficiently big in all time steps, we should
+                // never enter this clause. If this happens, the values of 0
+                // vill be used.
                 this->pcout << "# NB: need larger cell buffer outside the "
                              "physical domain." << std::endl;
             } else {
                 // Get the function values from the previous time steps.
-                // TODO check that this is actually done.
-                hp_fe_values.reinit(cell_prev);
-                const FEValues<dim> &fe_values_prev = hp_fe_values.get_present_fe_values();
-                fe_values_prev.get_function_values(this->solutions[k],
-                                                   prev_solution_values[k]);
+                (*fe_values_prev)[u].get_function_values_from_local_dof_values(
+                        local_dof_values, prev_solution_values[k]);
             }
         }
 
@@ -513,12 +531,7 @@ namespace utils::problems::scalar {
         }
         data_out.add_data_vector(subdomain, "subdomain");
         data_out.build_patches();
-        data_out.write_vtu_with_pvtu_record(
-            "", "solution-d" + std::to_string(dim)
-                 + "o" + std::to_string(this->element_order)
-                 + "r" + std::to_string(this->n_refines),
-            time_step, this->mpi_communicator, 2, 8);
-            // TODO adjust file name.
+        this->write_data_out(data_out, "solution", time_step);
 
         // Output levelset function.
         if (!minimal_output) {
@@ -73,7 +73,8 @@ namespace utils::problems::scalar {
                       Function<dim> &analytical_soln,
                       const bool stabilized = true,
                       const bool stationary = false,
-                      const bool compute_error = true);
+                      const bool compute_error = true,
+                      const MPI_Comm &mpi_communicator = MPI_COMM_WORLD);
 
         void
         write_header_to_file(std::ofstream &file);
@@ -92,6 +93,11 @@ namespace utils::problems::scalar {
         virtual void
         assemble_system() override;
 
+        virtual void
+        assemble_mass_matrix_local_over_cell(
+                const FEValues<dim> &fe_values,
+                const std::vector<types::global_dof_index> &loc2glb) override;
+
         virtual void
         assemble_rhs_and_bdf_terms_local_over_cell(
                 const FEValues<dim> &fe_values,
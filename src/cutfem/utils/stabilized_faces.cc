@@ -0,0 +1,232 @@
+#include <deal.II/base/geometry_info.h>
+
+#include <deal.II/fe/fe.h>
+
+#include "stabilized_faces.h"
+
+
+namespace utils {
+
+    using NonMatching::LocationToLevelSet;
+
+    template<int dim>
+    StabilizedFaces<dim>::
+    StabilizedFaces(const NonMatching::MeshClassifier<dim> &mesh_classifier)
+            : mesh_classifier(&mesh_classifier) {}
+
+
+    template<int dim>
+    unsigned int StabilizedFaces<dim>::
+    update(const hp::DoFHandler<dim> &dof_handler,
+           const unsigned int n_band_layers) {
+        const unsigned int n_cells =
+                dof_handler.get_triangulation().n_active_cells();
+        const bool full_update = cell_locations.size() != n_cells;
+        if (full_update) {
+            cell_locations.assign(n_cells, LocationToLevelSet::outside);
+            cell_has_dofs.assign(n_cells, false);
+            face_flags.assign(n_cells * GeometryInfo<dim>::faces_per_cell,
+                              false);
+            band_marks.assign(n_cells, false);
+            band_seeds.clear();
+        }
+
+        std::vector<typename hp::DoFHandler<dim>::active_cell_iterator> cells;
+        if (full_update || n_band_layers == numbers::invalid_unsigned_int) {
+            for (const auto &cell : dof_handler.active_cell_iterators()) {
+                if (!cell->is_artificial()) {
+                    cells.push_back(cell);
+                }
+            }
+        } else {
+            cells = collect_band_cells(dof_handler, n_band_layers);
+        }
+
+        // First update the cached cell data, such that it is up to date for
+        // both cells of a face when the face flags are computed below.
+        std::vector<typename hp::DoFHandler<dim>::active_cell_iterator>
+                changed_cells;
+        for (const auto &cell : cells) {
+            const unsigned int index = cell->active_cell_index();
+            const LocationToLevelSet location =
+                    mesh_classifier->location_to_level_set(cell);
+            const bool has_dofs = cell->get_fe().n_dofs_per_cell() > 0;
+            if (full_update || location != cell_locations[index] ||
+                has_dofs != cell_has_dofs[index]) {
+                cell_locations[index] = location;
+                cell_has_dofs[index] = has_dofs;
+                changed_cells.push_back(cell);
+            }
+        }
+
+        // The flags of a face depend on both the cells sharing it, so the
+        // neighbors of the changed cells are updated too.
+        for (const auto &cell : changed_cells) {
+            update_face_flags(cell);
+            if (full_update) {
+                continue;
+            }
+            for (const unsigned int f : cell->face_indices()) {
+                if (cell->at_boundary(f) || cell->neighbor(f)->has_children()) {
+                    continue;
+                }
+                const typename hp::DoFHandler<dim>::active_cell_iterator
+                        neighbor = cell->neighbor(f);
+                if (!neighbor->is_artificial()) {
+                    update_face_flags(neighbor);
+                }
+            }
+        }
+
+        // No cell outside the band changed, so the seeds of the next update
+        // are all in the band.
+        band_seeds.clear();
+        for (const auto &cell : cells) {
+            if (is_band_seed(cell)) {
+                band_seeds.push_back(cell);
+            }
+        }
+        return changed_cells.size();
+    }
+
+
+    template<int dim>
+    void StabilizedFaces<dim>::
+    clear() {
+        cell_locations.clear();
+        cell_has_dofs.clear();
+        face_flags.clear();
+        band_seeds.clear();
+        band_marks.clear();
+    }
+
+
+    template<int dim>
+    std::vector<typename hp::DoFHandler<dim>::active_cell_iterator>
+    StabilizedFaces<dim>::
+    collect_band_cells(const hp::DoFHandler<dim> &dof_handler,
+                       const unsigned int n_band_layers) {
+        using active_cell_iterator =
+                typename hp::DoFHandler<dim>::active_cell_iterator;
+        std::vector<active_cell_iterator> band;
+        for (const auto &seed : band_seeds) {
+            const active_cell_iterator cell(&dof_handler.get_triangulation(),
+                                            seed->level(), seed->index(),
+                                            &dof_handler);
+            band_marks[cell->active_cell_index()] = true;
+            band.push_back(cell);
+        }
+
+        // Add one layer of face neighbors at a time.
+        unsigned int layer_begin = 0;
+        for (unsigned int layer = 0; layer < n_band_layers; ++layer) {
+            const unsigned int layer_end = band.size();
+            for (unsigned int i = layer_begin; i < layer_end; ++i) {
+                const active_cell_iterator cell = band[i];
+                for (const unsigned int f : cell->face_indices()) {
+                    if (cell->at_boundary(f) ||
+                        cell->neighbor(f)->has_children()) {
+                        continue;
+                    }
+                    const active_cell_iterator neighbor = cell->neighbor(f);
+                    if (neighbor->is_artificial() ||
+                        band_marks[neighbor->active_cell_index()]) {
+                        continue;
+                    }
+                    band_marks[neighbor->active_cell_index()] = true;
+                    band.push_back(neighbor);
+                }
+            }
+            layer_begin = layer_end;
+        }
+
+        for (const auto &cell : band) {
+            band_marks[cell->active_cell_index()] = false;
+        }
+        return band;
+    }
+
+
+    template<int dim>
+    bool StabilizedFaces<dim>::
+    is_band_seed(
+            const typename hp::DoFHandler<dim>::active_cell_iterator &cell) const {
+        const unsigned int index = cell->active_cell_index();
+        if (cell_locations[index] == LocationToLevelSet::intersected) {
+            return true;
+        }
+        for (const unsigned int f : cell->face_indices()) {
+            if (cell->at_boundary(f) || cell->neighbor(f)->has_children()) {
+                continue;
+            }
+            const typename hp::DoFHandler<dim>::active_cell_iterator
+                    neighbor = cell->neighbor(f);
+            if (!neighbor->is_artificial() &&
+                cell_has_dofs[neighbor->active_cell_index()] !=
+                cell_has_dofs[index]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+
+    template<int dim>
+    bool StabilizedFaces<dim>::
+    face_should_be_stabilized(
+            const typename hp::DoFHandler<dim>::active_cell_iterator &cell,
+            const unsigned int face_index) const {
+        if (cell->is_artificial()) {
+            return false;
+        }
+        return face_flags[cell->active_cell_index() *
+                          GeometryInfo<dim>::faces_per_cell + face_index];
+    }
+
+
+    template<int dim>
+    bool StabilizedFaces<dim>::
+    face_has_flux_coupling(
+            const typename hp::DoFHandler<dim>::active_cell_iterator &cell,
+            const unsigned int face_index) const {
+        // Only the ghost penalty couples the dofs over the faces.
+        return face_should_be_stabilized(cell, face_index);
+    }
+
+
+    template<int dim>
+    void StabilizedFaces<dim>::
+    update_face_flags(
+            const typename hp::DoFHandler<dim>::active_cell_iterator &cell) {
+        const unsigned int index = cell->active_cell_index();
+        const unsigned int first_face =
+                index * GeometryInfo<dim>::faces_per_cell;
+        for (const unsigned int f : cell->face_indices()) {
+            bool stabilize = false;
+            if (!cell->at_boundary(f) && !cell->neighbor(f)->has_children()) {
+                const typename hp::DoFHandler<dim>::active_cell_iterator
+                        neighbor = cell->neighbor(f);
+                const unsigned int neighbor_index =
+                        neighbor->active_cell_index();
+                // We shouldn't stabilize between FENothing elements, or
+                // between two elements inside the domain.
+                stabilize = !neighbor->is_artificial() &&
+                            cell_has_dofs[index] &&
+                            cell_has_dofs[neighbor_index] &&
+                            !(cell_locations[index] ==
+                              LocationToLevelSet::inside &&
+                              cell_locations[neighbor_index] ==
+                              LocationToLevelSet::inside);
+            }
+            face_flags[first_face + f] = stabilize;
+        }
+    }
+
+
+    template
+    class StabilizedFaces<2>;
+
+    template
+    class StabilizedFaces<3>;
+
+} // namespace utils
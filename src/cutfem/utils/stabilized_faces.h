@@ -0,0 +1,142 @@
+#ifndef MICROBUBBLE_UTILS_STABILIZED_FACES_H
+#define MICROBUBBLE_UTILS_STABILIZED_FACES_H
+
+#include <deal.II/base/numbers.h>
+#include <deal.II/base/smartpointer.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/hp/dof_handler.h>
+
+#include <deal.II/non_matching/mesh_classifier.h>
+
+#include <vector>
+
+#include "stabilization/face_selectors.h"
+
+
+using namespace dealii;
+using namespace cutfem;
+
+namespace utils {
+
+    /**
+     * A face selector that caches which faces should be stabilized in a
+     * bitset, with one bit for each face of each active cell (indexed by
+     * active_cell_index()).
+     *
+     * A face is stabilized with the same rule as in Selector: it must be an
+     * interior face between two cells with degrees of freedom, and not both
+     * of the cells can be inside the domain.
+     *
+     * The flags are recomputed by update() after the mesh classifier was
+     * reclassified and the dofs were distributed. update() only recomputes
+     * the flags of the cells where the location to the level set or the
+     * active FE index changed since the last call, together with their face
+     * neighbors. For a moving domain, the cells are only checked in the band
+     * swept by the interface and by the edge of the active cells: the given
+     * number of layers of cells around the cells that were intersected or at
+     * the edge of the active cells at the last update. The cells outside the
+     * band are not visited at all. The mesh classifier is still reclassified on
+     * all the cells, since NonMatching::MeshClassifier can't reclassify a part
+     * of the mesh.
+     *
+     * The same flags are used by the ghost penalty assembly (through the
+     * FaceSelector interface) and to restrict the face couplings of the
+     * sparsity pattern, see face_has_flux_coupling().
+     *
+     * @tparam dim
+     */
+    template<int dim>
+    class StabilizedFaces : public stabilization::FaceSelector<dim> {
+    public:
+        StabilizedFaces(const NonMatching::MeshClassifier<dim> &mesh_classifier);
+
+        /**
+         * Update the cached cell locations and face flags. If the number of
+         * active cells changed since the last call, all the flags are
+         * recomputed.
+         *
+         * @param n_band_layers: the number of layers of cells around the
+         * interface and the edge of the active cells of the last update
+         * that are checked for changes. This must cover the distance the
+         * interface moved since the last update. With the default value,
+         * all the cells are checked.
+         * @return the number of cells that changed location or active FE
+         * index.
+         */
+        unsigned int
+        update(const hp::DoFHandler<dim> &dof_handler,
+               unsigned int n_band_layers = numbers::invalid_unsigned_int);
+
+        /**
+         * Make the next call to update() recompute all the flags, e.g. after
+         * the triangulation was refined.
+         */
+        void
+        clear();
+
+        bool
+        face_should_be_stabilized(
+                const typename hp::DoFHandler<dim>::active_cell_iterator &cell,
+                unsigned int face_index) const override;
+
+        /**
+         * Return true if the dofs of the cell and the neighbor over the face
+         * should couple in the sparsity pattern. This has the signature used
+         * by DoFTools::make_flux_sparsity_pattern().
+         */
+        bool
+        face_has_flux_coupling(
+                const typename hp::DoFHandler<dim>::active_cell_iterator &cell,
+                unsigned int face_index) const;
+
+    private:
+        /**
+         * Return the cells within n_band_layers face neighbors of the cells
+         * in band_seeds.
+         */
+        std::vector<typename hp::DoFHandler<dim>::active_cell_iterator>
+        collect_band_cells(const hp::DoFHandler<dim> &dof_handler,
+                           unsigned int n_band_layers);
+
+        /**
+         * Return true if the cell is intersected, or if it has dofs and a
+         * face neighbor doesn't, or the other way around.
+         */
+        bool
+        is_band_seed(
+                const typename hp::DoFHandler<dim>::active_cell_iterator &cell) const;
+
+        /**
+         * Recompute the flags of all the faces of the cell.
+         */
+        void
+        update_face_flags(
+                const typename hp::DoFHandler<dim>::active_cell_iterator &cell);
+
+        const SmartPointer<const NonMatching::MeshClassifier<dim>> mesh_classifier;
+
+        // The location to the level set of each active cell at the last
+        // update.
+        std::vector<NonMatching::LocationToLevelSet> cell_locations;
+
+        // True for the cells that had degrees of freedom at the last update.
+        std::vector<bool> cell_has_dofs;
+
+        // The flag of face f of cell i is stored in
+        //   face_flags[i * GeometryInfo<dim>::faces_per_cell + f].
+        std::vector<bool> face_flags;
+
+        // The cells that were intersected or at the edge of the active
+        // cells at the last update, from which the band of cells to check is
+        // grown in the next update.
+        std::vector<typename Triangulation<dim>::active_cell_iterator> band_seeds;
+        // Marks the cells already added in collect_band_cells(). Only the
+        // marks of the band are set, and they are reset before returning.
+        std::vector<bool> band_marks;
+    };
+
+} // namespace utils
+
+#endif //MICROBUBBLE_UTILS_STABILIZED_FACES_H
@@ -0,0 +1,204 @@
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/utilities.h>
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+
+#include "surface_output.h"
+
+
+namespace utils {
+
+    template<int dim>
+    SurfaceOutput<dim>::
+    SurfaceOutput(const std::string &basename,
+                  const MPI_Comm &mpi_communicator,
+                  const std::vector<std::string> &field_names,
+                  const std::vector<unsigned int> &field_components)
+            : basename(basename), mpi_communicator(mpi_communicator),
+              field_names(field_names), field_components(field_components) {
+        if (field_names.size() != field_components.size()) {
+            throw std::invalid_argument(
+                    "The number of field names and of field components "
+                    "differ.");
+        }
+        point_size = 6;
+        for (const unsigned int components : field_components) {
+            if (components != 1 && components != dim) {
+                throw std::invalid_argument(
+                        "A field must have 1 or dim components.");
+            }
+            point_size += components;
+        }
+    }
+
+
+    template<int dim>
+    void SurfaceOutput<dim>::
+    clear() {
+        point_data.clear();
+        cell_sizes.clear();
+    }
+
+
+    template<int dim>
+    void SurfaceOutput<dim>::
+    add_cell(const std::vector<Point<dim>> &points,
+             const std::vector<Tensor<1, dim>> &normals,
+             const std::vector<std::vector<double>> &values) {
+        const unsigned int n_points = points.size();
+        if (n_points == 0) {
+            return;
+        }
+
+        // In 2D, order the points along the tangent of the mean normal,
+        // such that the polyline follows the surface through the cell.
+        std::vector<unsigned int> order(n_points);
+        std::iota(order.begin(), order.end(), 0);
+        if (dim == 2) {
+            Tensor<1, dim> mean_normal;
+            for (const Tensor<1, dim> &normal : normals) {
+                mean_normal += normal;
+            }
+            Tensor<1, dim> tangent;
+            tangent[0] = -mean_normal[1];
+            tangent[1] = mean_normal[0];
+            std::sort(order.begin(), order.end(),
+                      [&](const unsigned int a, const unsigned int b) {
+                          return (points[a] - points[0]) * tangent <
+                                 (points[b] - points[0]) * tangent;
+                      });
+        }
+
+        for (const unsigned int q : order) {
+            for (unsigned int d = 0; d < 3; ++d) {
+                point_data.push_back(d < dim ? points[q][d] : 0);
+            }
+            for (unsigned int d = 0; d < 3; ++d) {
+                point_data.push_back(d < dim ? normals[q][d] : 0);
+            }
+            point_data.insert(point_data.end(), values[q].begin(),
+                              values[q].end());
+        }
+        cell_sizes.push_back(n_points);
+    }
+
+
+    template<int dim>
+    void SurfaceOutput<dim>::
+    write(const unsigned int step, const double time) {
+        // The surface is small, so it is written by a single process.
+        const std::vector<std::vector<double>> all_point_data =
+                Utilities::MPI::gather(mpi_communicator, point_data, 0);
+        const std::vector<std::vector<unsigned int>> all_cell_sizes =
+                Utilities::MPI::gather(mpi_communicator, cell_sizes, 0);
+        clear();
+        if (Utilities::MPI::this_mpi_process(mpi_communicator) != 0) {
+            return;
+        }
+
+        unsigned int n_points = 0;
+        unsigned int n_cells = 0;
+        for (unsigned int i = 0; i < all_cell_sizes.size(); ++i) {
+            n_points += all_point_data[i].size() / point_size;
+            n_cells += all_cell_sizes[i].size();
+        }
+
+        const std::string filename =
+                basename + "-" + Utilities::int_to_string(step, 4) + ".vtu";
+        std::ofstream file(filename);
+        file.precision(12);
+        file << "<?xml version=\"1.0\"?>\n"
+             << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" "
+                "byte_order=\"LittleEndian\">\n"
+             << "<UnstructuredGrid>\n"
+             << "<Piece NumberOfPoints=\"" << n_points
+             << "\" NumberOfCells=\"" << n_cells << "\">\n";
+
+        // Write the values at the given offset of each point.
+        const auto write_point_values = [&](const unsigned int offset,
+                                            const unsigned int n_values) {
+            for (const std::vector<double> &data : all_point_data) {
+                for (unsigned int i = 0; i < data.size(); i += point_size) {
+                    for (unsigned int d = 0; d < n_values; ++d) {
+                        file << data[i + offset + d] << " ";
+                    }
+                    // Vectors are padded to 3 components in VTK.
+                    for (unsigned int d = n_values; d < 3 && n_values > 1; ++d) {
+                        file << 0 << " ";
+                    }
+                }
+            }
+            file << "\n";
+        };
+
+        file << "<Points>\n"
+             << "<DataArray type=\"Float64\" NumberOfComponents=\"3\" "
+                "format=\"ascii\">\n";
+        write_point_values(0, 3);
+        file << "</DataArray>\n"
+             << "</Points>\n";
+
+        file << "<Cells>\n"
+             << "<DataArray type=\"Int32\" Name=\"connectivity\" "
+                "format=\"ascii\">\n";
+        for (unsigned int i = 0; i < n_points; ++i) {
+            file << i << " ";
+        }
+        file << "\n</DataArray>\n"
+             << "<DataArray type=\"Int32\" Name=\"offsets\" "
+                "format=\"ascii\">\n";
+        unsigned int offset = 0;
+        for (const std::vector<unsigned int> &sizes : all_cell_sizes) {
+            for (const unsigned int size : sizes) {
+                offset += size;
+                file << offset << " ";
+            }
+        }
+        file << "\n</DataArray>\n"
+             << "<DataArray type=\"UInt8\" Name=\"types\" "
+                "format=\"ascii\">\n";
+        // VTK_VERTEX = 1, VTK_POLY_VERTEX = 2 and VTK_POLY_LINE = 4.
+        for (const std::vector<unsigned int> &sizes : all_cell_sizes) {
+            for (const unsigned int size : sizes) {
+                file << (size == 1 ? 1 : (dim == 2 ? 4 : 2)) << " ";
+            }
+        }
+        file << "\n</DataArray>\n"
+             << "</Cells>\n";
+
+        file << "<PointData>\n"
+             << "<DataArray type=\"Float64\" Name=\"normal\" "
+                "NumberOfComponents=\"3\" format=\"ascii\">\n";
+        write_point_values(3, 3);
+        file << "</DataArray>\n";
+        unsigned int field_offset = 6;
+        for (unsigned int f = 0; f < field_names.size(); ++f) {
+            const unsigned int components = field_components[f];
+            file << "<DataArray type=\"Float64\" Name=\"" << field_names[f]
+                 << "\" NumberOfComponents=\"" << (components == 1 ? 1 : 3)
+                 << "\" format=\"ascii\">\n";
+            write_point_values(field_offset, components);
+            file << "</DataArray>\n";
+            field_offset += components;
+        }
+        file << "</PointData>\n"
+             << "</Piece>\n"
+             << "</UnstructuredGrid>\n"
+             << "</VTKFile>\n";
+
+        times_and_names.emplace_back(time, filename);
+        std::ofstream pvd_file(basename + ".pvd");
+        DataOutBase::write_pvd_record(pvd_file, times_and_names);
+    }
+
+
+    template
+    class SurfaceOutput<2>;
+
+    template
+    class SurfaceOutput<3>;
+
+} // namespace utils
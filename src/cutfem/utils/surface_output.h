@@ -0,0 +1,93 @@
+#ifndef MICROBUBBLE_UTILS_SURFACE_OUTPUT_H
+#define MICROBUBBLE_UTILS_SURFACE_OUTPUT_H
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/tensor.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+
+using namespace dealii;
+
+namespace utils {
+
+    /**
+     * Output of quantities on an immersed surface (e.g. the interface of a
+     * bubble), sampled in the points of the surface quadrature of the cut
+     * cells, instead of fields on the whole background mesh.
+     *
+     * The points of each cut cell are added with add_cell(). In 2D, the
+     * points of a cell are sorted along the surface and connected as a
+     * polyline, such that the interface is drawn as a curve. In 3D, the
+     * points of a cell are written as a point cloud (a poly vertex cell).
+     *
+     * In each call to write(), the points of all the processes are gathered
+     * on process 0, which writes a single file <basename>-<step>.vtu, and
+     * updates the record <basename>.pvd of all the steps written so far. The
+     * surface is only a small fraction of the mesh, so the output is orders of
+     * magnitude smaller than the output of the fields.
+     *
+     * @tparam dim
+     */
+    template<int dim>
+    class SurfaceOutput {
+    public:
+        /**
+         * @param field_names: the names of the fields given in each point.
+         * @param field_components: the number of components of each field,
+         * either 1 (a scalar) or dim (a vector).
+         */
+        SurfaceOutput(const std::string &basename,
+                      const MPI_Comm &mpi_communicator,
+                      const std::vector<std::string> &field_names,
+                      const std::vector<unsigned int> &field_components);
+
+        /**
+         * Remove the points added since the last call to write().
+         */
+        void
+        clear();
+
+        /**
+         * Add the surface quadrature points of a cut cell.
+         *
+         * @param normals: the unit normals of the surface in the points.
+         * @param values: the values of all the fields in each point, with the
+         * components of the fields after each other.
+         */
+        void
+        add_cell(const std::vector<Point<dim>> &points,
+                 const std::vector<Tensor<1, dim>> &normals,
+                 const std::vector<std::vector<double>> &values);
+
+        /**
+         * Write the points added since the last call to clear() as the given
+         * step, and clear them. This is collective over the communicator.
+         */
+        void
+        write(unsigned int step, double time);
+
+    private:
+        const std::string basename;
+        const MPI_Comm mpi_communicator;
+        const std::vector<std::string> field_names;
+        const std::vector<unsigned int> field_components;
+
+        // The number of values of each point: the coordinates and the normal
+        // (padded to 3 components), and the fields.
+        unsigned int point_size;
+
+        // The data of the local points, and the number of points of each cell.
+        std::vector<double> point_data;
+        std::vector<unsigned int> cell_sizes;
+
+        // The times and files of the steps written so far, for the pvd-record.
+        std::vector<std::pair<double, std::string>> times_and_names;
+    };
+
+} // namespace utils
+
+#endif //MICROBUBBLE_UTILS_SURFACE_OUTPUT_H
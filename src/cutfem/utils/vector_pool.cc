@@ -0,0 +1,99 @@
+#include "vector_pool.h"
+#include "cutfem_problem.h"
+
+
+namespace utils {
+
+    template<typename VectorType>
+    VectorPool<VectorType>::
+    VectorPool(const MPI_Comm &mpi_communicator,
+               const unsigned int max_free_vectors)
+            : mpi_communicator(mpi_communicator),
+              max_free_vectors(max_free_vectors) {}
+
+
+    template<typename VectorType>
+    void VectorPool<VectorType>::
+    reinit(const IndexSet &owned_dofs, const IndexSet &relevant_dofs) {
+        if (owned_dofs == locally_owned_dofs &&
+            relevant_dofs == locally_relevant_dofs) {
+            return;
+        }
+        clear();
+        locally_owned_dofs = owned_dofs;
+        locally_relevant_dofs = relevant_dofs;
+        ghost_dofs = relevant_dofs;
+        ghost_dofs.subtract_set(owned_dofs);
+    }
+
+
+    template<typename VectorType>
+    void VectorPool<VectorType>::
+    acquire_ghosted(VectorType &vector) {
+        if (free_ghosted.empty()) {
+            vector.reinit(locally_owned_dofs, locally_relevant_dofs,
+                          mpi_communicator);
+            return;
+        }
+        vector.swap(free_ghosted.back());
+        free_ghosted.pop_back();
+        vector = 0;
+    }
+
+
+    template<typename VectorType>
+    void VectorPool<VectorType>::
+    acquire_owned(VectorType &vector) {
+        if (free_owned.empty()) {
+            vector.reinit(locally_owned_dofs, mpi_communicator);
+            return;
+        }
+        vector.swap(free_owned.back());
+        free_owned.pop_back();
+        vector = 0;
+    }
+
+
+    template<typename VectorType>
+    void VectorPool<VectorType>::
+    release(VectorType &vector) {
+        if (!has_current_partitioning(vector)) {
+            vector.clear();
+            return;
+        }
+        std::deque<VectorType> &free_vectors =
+                vector.has_ghost_elements() ? free_ghosted : free_owned;
+        if (free_vectors.size() < max_free_vectors) {
+            free_vectors.emplace_back();
+            free_vectors.back().swap(vector);
+        }
+        vector.clear();
+    }
+
+
+    template<typename VectorType>
+    void VectorPool<VectorType>::
+    clear() {
+        free_ghosted.clear();
+        free_owned.clear();
+    }
+
+
+    template<typename VectorType>
+    bool VectorPool<VectorType>::
+    has_current_partitioning(const VectorType &vector) const {
+        if (vector.size() != locally_owned_dofs.size() ||
+            vector.locally_owned_elements() != locally_owned_dofs) {
+            return false;
+        }
+        if (vector.has_ghost_elements()) {
+            return vector.ghost_elements() == ghost_dofs;
+        }
+        return true;
+    }
+
+
+    template
+    class VectorPool<LA::MPI::Vector>;
+
+} // namespace utils
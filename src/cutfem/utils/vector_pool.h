@@ -0,0 +1,92 @@
+#ifndef MICROBUBBLE_UTILS_VECTOR_POOL_H
+#define MICROBUBBLE_UTILS_VECTOR_POOL_H
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
+
+#include <deque>
+
+
+using namespace dealii;
+
+namespace utils {
+
+    /**
+     * A pool of recycled distributed vectors, used to avoid allocating (and
+     * setting up the ghost exchange for) new vectors in each time step.
+     *
+     * The pool holds vectors with one partitioning, set by reinit(). A vector
+     * is taken from the pool with acquire_ghosted() or acquire_owned(), which
+     * only creates a new vector if no free vector is available. When it is no
+     * longer needed it is handed back with release(). The vectors are moved
+     * in and out of the pool with swap(), so no data is copied. Released
+     * vectors with a different partitioning than the current one are simply
+     * destroyed, so it is always safe to release a vector.
+     *
+     * At most max_free_vectors of each kind are kept in the pool, so this
+     * works as a ring buffer for e.g. the BDF history, where one vector is
+     * released for each vector acquired.
+     *
+     * @tparam VectorType: a distributed vector with ghost elements, e.g.
+     * LA::MPI::Vector.
+     */
+    template<typename VectorType>
+    class VectorPool {
+    public:
+        VectorPool(const MPI_Comm &mpi_communicator,
+                   unsigned int max_free_vectors = 8);
+
+        /**
+         * Set the partitioning of the vectors in the pool. If it differs from
+         * the previous one, the free vectors are destroyed.
+         */
+        void
+        reinit(const IndexSet &locally_owned_dofs,
+               const IndexSet &locally_relevant_dofs);
+
+        /**
+         * Reinitialize the given vector to a zero vector with ghost elements,
+         * by swapping it with a free vector from the pool.
+         */
+        void
+        acquire_ghosted(VectorType &vector);
+
+        /**
+         * Reinitialize the given vector to a zero vector without ghost
+         * elements, by swapping it with a free vector from the pool.
+         */
+        void
+        acquire_owned(VectorType &vector);
+
+        /**
+         * Hand the content of the vector back to the pool. The vector is left
+         * empty.
+         */
+        void
+        release(VectorType &vector);
+
+        /**
+         * Destroy all the free vectors.
+         */
+        void
+        clear();
+
+    private:
+        bool
+        has_current_partitioning(const VectorType &vector) const;
+
+        const MPI_Comm mpi_communicator;
+        const unsigned int max_free_vectors;
+
+        IndexSet locally_owned_dofs;
+        IndexSet locally_relevant_dofs;
+        // The ghost indices, that is the relevant dofs that are not owned.
+        IndexSet ghost_dofs;
+
+        std::deque<VectorType> free_ghosted;
+        std::deque<VectorType> free_owned;
+    };
+
+} // namespace utils
+
+#endif //MICROBUBBLE_UTILS_VECTOR_POOL_H
@@ -0,0 +1,117 @@
+#ifndef MICROBUBBLE_UTILS_VECTORIZED_FUNCTION_H
+#define MICROBUBBLE_UTILS_VECTORIZED_FUNCTION_H
+
+#include <deal.II/base/point.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <algorithm>
+#include <vector>
+
+
+using namespace dealii;
+
+namespace utils {
+
+    /**
+     * Evaluate a function in a list of points in batches of
+     * VectorizedArray<double>::size() points, such that the function itself
+     * can be written with SIMD arithmetic.
+     *
+     * The points are copied to structure-of-arrays form, that is a
+     * Point<dim, VectorizedArray<double>> where each lane holds one point.
+     * If the number of points is not divisible by the batch size, the lanes
+     * of the last batch are padded with the last point, so the function is
+     * never evaluated in a point that is not in the list.
+     *
+     * @param batch_function: callable taking a
+     * Point<dim, VectorizedArray<double>>, and returning either a
+     * VectorizedArray<double> or a Tensor<1, dim, VectorizedArray<double>>.
+     * @param values: resized to the number of points.
+     */
+    template<int dim, typename ValueType, typename BatchFunction>
+    void
+    evaluate_in_batches(const std::vector<Point<dim>> &points,
+                        std::vector<ValueType> &values,
+                        const BatchFunction &batch_function);
+
+
+    namespace internal {
+
+        inline void
+        extract_lane(const VectorizedArray<double> &batch_value,
+                     const unsigned int lane,
+                     double &value) {
+            value = batch_value[lane];
+        }
+
+        template<int dim>
+        inline void
+        extract_lane(const Tensor<1, dim, VectorizedArray<double>> &batch_value,
+                     const unsigned int lane,
+                     Tensor<1, dim> &value) {
+            for (unsigned int d = 0; d < dim; ++d) {
+                value[d] = batch_value[d][lane];
+            }
+        }
+
+    } // namespace internal
+
+
+    /**
+     * Evaluate the level set of the flower domain, eq (2.122) in
+     * Gürkan–Massing (2019) for z = 0,
+     *   φ = sqrt(x² + y²) - r + (r / r0) cos(5 atan2(y, x)),
+     * in a batch of points (x, y) relative to the center of the flower.
+     */
+    inline VectorizedArray<double>
+    flower_levelset_value(const VectorizedArray<double> &x,
+                          const VectorizedArray<double> &y,
+                          const double r,
+                          const double r0) {
+        const VectorizedArray<double> x2 = x * x;
+        const VectorizedArray<double> y2 = y * y;
+        const VectorizedArray<double> r2 = x2 + y2;
+        const VectorizedArray<double> radius = std::sqrt(r2);
+        // Write cos(5 atan2(y, x)) as Re((x + iy)^5) / |x + iy|^5, since
+        // atan2 is not available for VectorizedArray. In the center,
+        // atan2(0, 0) = 0 gives cos(0) = 1.
+        const VectorizedArray<double> cos_5theta =
+                compare_and_apply_mask<SIMDComparison::equal>(
+                        r2, make_vectorized_array(0.0),
+                        make_vectorized_array(1.0),
+                        x * (x2 * x2 - 10.0 * x2 * y2 + 5.0 * y2 * y2) /
+                        (r2 * r2 * radius));
+        return radius - r + (r / r0) * cos_5theta;
+    }
+
+
+    template<int dim, typename ValueType, typename BatchFunction>
+    void
+    evaluate_in_batches(const std::vector<Point<dim>> &points,
+                        std::vector<ValueType> &values,
+                        const BatchFunction &batch_function) {
+        constexpr unsigned int n_lanes = VectorizedArray<double>::size();
+        const unsigned int n_points = points.size();
+        values.resize(n_points);
+
+        Point<dim, VectorizedArray<double>> batch;
+        for (unsigned int start = 0; start < n_points; start += n_lanes) {
+            const unsigned int n_filled = std::min(n_lanes, n_points - start);
+            for (unsigned int lane = 0; lane < n_lanes; ++lane) {
+                const Point<dim> &point =
+                        points[start + std::min(lane, n_filled - 1)];
+                for (unsigned int d = 0; d < dim; ++d) {
+                    batch[d][lane] = point[d];
+                }
+            }
+            const auto batch_value = batch_function(batch);
+            for (unsigned int lane = 0; lane < n_filled; ++lane) {
+                internal::extract_lane(batch_value, lane, values[start + lane]);
+            }
+        }
+    }
+
+} // namespace utils
+
+#endif //MICROBUBBLE_UTILS_VECTORIZED_FUNCTION_H
@@ -0,0 +1,22 @@
+#ifndef MICROBUBBLE_NITSCHE_LINEAR_ALGEBRA_H
+#define MICROBUBBLE_NITSCHE_LINEAR_ALGEBRA_H
+
+#include <deal.II/lac/generic_linear_algebra.h>
+
+// The same choice of parallel linear algebra as for the CutFEM solvers in
+// cutfem/utils/cutfem_problem.h, such that the reference solutions are
+// computed with the same backend.
+namespace LA
+{
+#if defined(DEAL_II_WITH_PETSC) && !defined(DEAL_II_PETSC_WITH_COMPLEX) && \
+!(defined(DEAL_II_WITH_TRILINOS) && defined(FORCE_USE_OF_TRILINOS))
+using namespace dealii::LinearAlgebraPETSc;
+# define USE_PETSC_LA
+#elif defined(DEAL_II_WITH_TRILINOS)
+using namespace dealii::LinearAlgebraTrilinos;
+#else
+# error DEAL_II_WITH_PETSC or DEAL_II_WITH_TRILINOS required
+#endif
+} // namespace LA
+
+#endif // MICROBUBBLE_NITSCHE_LINEAR_ALGEBRA_H
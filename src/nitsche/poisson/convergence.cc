@@ -2,6 +2,9 @@
 #include <iostream>
 #include <vector>
 #include <fstream>
+
+#include <deal.II/base/mpi.h>
+
 #include "poisson.h"
 
 
@@ -41,6 +44,7 @@ void run_convergence_test(std::vector<int> orders, int max_refinement,
 }
 
 
-int main() {
+int main(int argc, char *argv[]) {
+    Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
     run_convergence_test<2>({1, 2}, 7, true);
 }
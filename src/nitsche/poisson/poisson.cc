@@ -5,7 +5,6 @@
 #include <deal.II/grid/tria_iterator.h>
 
 #include <deal.II/dofs/dof_tools.h>
-#include <deal.II/dofs/dof_renumbering.h>
 
 #include <deal.II/fe/fe_q.h>
 #include <deal.II/fe/fe_values.h>
@@ -13,6 +12,7 @@
 #include <deal.II/base/function.h>
 #include <deal.II/base/logstream.h>
 #include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/utilities.h>
 
 #include <deal.II/numerics/data_out.h>
 #include <deal.II/numerics/matrix_tools.h>
@@ -20,8 +20,9 @@
 
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/full_matrix.h>
-#include <deal.II/lac/precondition.h>
-#include <deal.II/lac/sparse_direct.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/sparsity_tools.h>
 #include <deal.II/lac/vector.h>
 
 #include <fstream>
@@ -33,9 +34,19 @@
 
 template<int dim>
 PoissonNitsche<dim>::PoissonNitsche(const unsigned int degree,
-                                    const unsigned int n_refines)
-        : degree(degree), n_refines(n_refines), fe(degree),
-          dof_handler(triangulation) {}
+                                    const unsigned int n_refines,
+                                    const MPI_Comm &mpi_communicator)
+        : degree(degree), n_refines(n_refines),
+          mpi_communicator(mpi_communicator),
+          triangulation(mpi_communicator,
+                        typename Triangulation<dim>::MeshSmoothing(
+                                Triangulation<dim>::smoothing_on_refinement |
+                                Triangulation<dim>::smoothing_on_coarsening)),
+          fe(degree), dof_handler(triangulation),
+          pcout(std::cout,
+                Utilities::MPI::this_mpi_process(mpi_communicator) == 0) {
+    constraints.close();
+}
 
 
 template<int dim>
@@ -45,34 +56,46 @@ void PoissonNitsche<dim>::make_grid() {
 
     triangulation.refine_global(n_refines);
 
-    // Write svg of grid to file.
-    if (dim == 2) {
+    // Write svg of grid to file. Each process only knows its own part of
+    // the distributed mesh, so this is only done for serial runs.
+    if (dim == 2 && Utilities::MPI::n_mpi_processes(mpi_communicator) == 1) {
         std::ofstream out("poisson-nitsche-grid.svg");
         GridOut grid_out;
         grid_out.write_svg(triangulation, out);
-        std::cout << "Grid written to file as svg." << std::endl;
+        pcout << "Grid written to file as svg." << std::endl;
     }
 
-    std::cout << "  Number of active cells: " << triangulation.n_active_cells()
-              << std::endl;
+    pcout << "  Number of active cells: "
+          << triangulation.n_global_active_cells() << std::endl;
 
 }
 
 template<int dim>
 void PoissonNitsche<dim>::setup_system() {
     dof_handler.distribute_dofs(fe);
-    std::cout << "  Number of degrees of freedom: " << dof_handler.n_dofs()
-              << std::endl;
-
-    DoFRenumbering::Cuthill_McKee(dof_handler);
-    DynamicSparsityPattern dsp(dof_handler.n_dofs(), dof_handler.n_dofs());
-    DoFTools::make_sparsity_pattern(dof_handler, dsp);
-
-    sparsity_pattern.copy_from(dsp);
-    system_matrix.reinit(sparsity_pattern);
-
-    solution.reinit(dof_handler.n_dofs());
-    system_rhs.reinit(dof_handler.n_dofs());
+    pcout << "  Number of degrees of freedom: " << dof_handler.n_dofs()
+          << std::endl;
+
+    locally_owned_dofs = dof_handler.locally_owned_dofs();
+    DoFTools::extract_locally_relevant_dofs(dof_handler,
+                                            locally_relevant_dofs);
+
+    DynamicSparsityPattern dsp(locally_relevant_dofs);
+    DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints, false);
+    SparsityTools::distribute_sparsity_pattern(dsp,
+                                               locally_owned_dofs,
+                                               mpi_communicator,
+                                               locally_relevant_dofs);
+
+    system_matrix.reinit(locally_owned_dofs,
+                         locally_owned_dofs,
+                         dsp,
+                         mpi_communicator);
+
+    solution.reinit(locally_owned_dofs,
+                    locally_relevant_dofs,
+                    mpi_communicator);
+    system_rhs.reinit(locally_owned_dofs, mpi_communicator);
 }
 
 template<int dim>
@@ -102,8 +125,12 @@ void PoissonNitsche<dim>::assemble_system() {
     std::vector<Tensor<1, dim>> grad_phi(dofs_per_cell);
     std::vector<double> g_values(fe_face_v.n_quadrature_points);
     Tensor<1, dim> normal;
+    std::vector<types::global_dof_index> local_dof_indices(dofs_per_cell);
 
     for (const auto &cell : dof_handler.active_cell_iterators()) {
+        if (!cell->is_locally_owned()) {
+            continue;
+        }
         fe_values.reinit(cell);
         cell_matrix = 0;
         cell_rhs = 0;
@@ -174,26 +201,53 @@ void PoissonNitsche<dim>::assemble_system() {
             }
         }
 
-        std::vector<types::global_dof_index> local_dof_indices(dofs_per_cell);
         cell->get_dof_indices(local_dof_indices);
-
-        for (unsigned int i = 0; i < dofs_per_cell; ++i) {
-            for (unsigned int j = 0; j < dofs_per_cell; ++j) {
-                system_matrix.add(local_dof_indices[i],
-                                  local_dof_indices[j],
-                                  cell_matrix(i, j));
-            }
-            system_rhs(local_dof_indices[i]) += cell_rhs(i);
-        }
+        constraints.distribute_local_to_global(cell_matrix,
+                                               cell_rhs,
+                                               local_dof_indices,
+                                               system_matrix,
+                                               system_rhs);
     }
+
+    system_matrix.compress(VectorOperation::add);
+    system_rhs.compress(VectorOperation::add);
+    h = Utilities::MPI::max(h, mpi_communicator);
 }
 
 template<int dim>
 void PoissonNitsche<dim>::solve() {
-    std::cout << "Solving system" << std::endl;
-    SparseDirectUMFPACK inverse;
-    inverse.initialize(system_matrix);
-    inverse.vmult(solution, system_rhs);
+    pcout << "Solving system" << std::endl;
+    LA::MPI::Vector completely_distributed_solution(locally_owned_dofs,
+                                                    mpi_communicator);
+
+    SolverControl solver_control(dof_handler.n_dofs(),
+                                 1e-12 * system_rhs.l2_norm());
+#ifdef USE_PETSC_LA
+    LA::SolverCG solver(solver_control, mpi_communicator);
+#else
+    LA::SolverCG solver(solver_control);
+#endif
+
+    // The Nitsche penalty is chosen large enough for the system to be
+    // symmetric positive definite.
+    LA::MPI::PreconditionAMG preconditioner;
+    LA::MPI::PreconditionAMG::AdditionalData data;
+#ifdef USE_PETSC_LA
+    data.symmetric_operator = true;
+#else
+    data.elliptic = true;
+    data.higher_order_elements = degree > 1;
+#endif
+    preconditioner.initialize(system_matrix, data);
+
+    solver.solve(system_matrix,
+                 completely_distributed_solution,
+                 system_rhs,
+                 preconditioner);
+    pcout << "  Solved in " << solver_control.last_step()
+          << " CG iterations." << std::endl;
+
+    solution = completely_distributed_solution;
 }
 
 template<int dim>
@@ -201,11 +255,19 @@ void PoissonNitsche<dim>::output_results() const {
     DataOut<dim> data_out;
     data_out.attach_dof_handler(dof_handler);
     data_out.add_data_vector(solution, "solution");
+
+    Vector<float> subdomain(triangulation.n_active_cells());
+    for (unsigned int i = 0; i < subdomain.size(); ++i) {
+        subdomain(i) = triangulation.locally_owned_subdomain();
+    }
+    data_out.add_data_vector(subdomain, "subdomain");
     data_out.build_patches();
-    std::ofstream out("solution-d" + std::to_string(dim)
-                      + "o" + std::to_string(degree)
-                      + "r" + std::to_string(n_refines) + ".vtk");
-    data_out.write_vtk(out);
+
+    data_out.write_vtu_with_pvtu_record(
+            "", "solution-d" + std::to_string(dim)
+                + "o" + std::to_string(degree)
+                + "r" + std::to_string(n_refines),
+            0, mpi_communicator, 2, 8);
 }
 
 template<int dim>
@@ -231,6 +293,9 @@ Error PoissonNitsche<dim>::compute_error() {
     Tensor<1, dim> diff_grad;
 
     for (const auto &cell : dof_handler.active_cell_iterators()) {
+        if (!cell->is_locally_owned()) {
+            continue;
+        }
         fe_v.reinit(cell);
 
         fe_v.get_function_values(solution, solution_values);
@@ -251,6 +316,11 @@ Error PoissonNitsche<dim>::compute_error() {
         }
     }
 
+    l2_error_integral = Utilities::MPI::sum(l2_error_integral,
+                                            mpi_communicator);
+    h1_semi_error_integral = Utilities::MPI::sum(h1_semi_error_integral,
+                                                 mpi_communicator);
+
     Error error;
     error.mesh_size = h;
     error.l2_error = pow(l2_error_integral, 0.5);
@@ -1,23 +1,37 @@
 #ifndef MICROBUBBLE_NITSCHE_POISSON_POISSON_H
 #define MICROBUBBLE_NITSCHE_POISSON_POISSON_H
 
-#include <deal.II/grid/tria.h>
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/distributed/tria.h>
 #include <deal.II/dofs/dof_handler.h>
 #include <deal.II/fe/fe_q.h>
+#include <deal.II/lac/affine_constraints.h>
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
-#include <deal.II/lac/sparse_matrix.h>
-#include <deal.II/lac/vector.h>
 
+#include "../linear_algebra.h"
 #include "rhs.h"
 
 using namespace dealii;
 
 
+/**
+ * Poisson's equation on a fitted mesh, with the Dirichlet boundary conditions
+ * imposed weakly by Nitsche's method. This is used as a reference solution
+ * for the CutFEM solvers.
+ *
+ * The mesh is a parallel::distributed::Triangulation, and the symmetric
+ * positive definite system is solved with CG, preconditioned with AMG, so
+ * the program can be run with mpirun on the same resolutions as the CutFEM
+ * runs.
+ */
 template<int dim>
 class PoissonNitsche {
 public:
     PoissonNitsche(const unsigned int degree,
-                   const unsigned int n_refines);
+                   const unsigned int n_refines,
+                   const MPI_Comm &mpi_communicator = MPI_COMM_WORLD);
 
     Error run();
 
@@ -43,13 +57,24 @@ private:
 
     double h = 0;
 
-    Triangulation<dim> triangulation;
+    MPI_Comm mpi_communicator;
+    parallel::distributed::Triangulation<dim> triangulation;
     FE_Q<dim> fe;
     DoFHandler<dim> dof_handler;
-    SparsityPattern sparsity_pattern;
-    SparseMatrix<double> system_matrix;
-    Vector<double> solution;
-    Vector<double> system_rhs;
+
+    IndexSet locally_owned_dofs;
+    IndexSet locally_relevant_dofs;
+    // No strong constraints are used, since the boundary conditions are
+    // imposed weakly. This is only used to distribute the local
+    // contributions.
+    AffineConstraints<double> constraints;
+
+    LA::MPI::SparseMatrix system_matrix;
+    // The solution with ghost elements, used for output and errors.
+    LA::MPI::Vector solution;
+    LA::MPI::Vector system_rhs;
+
+    ConditionalOStream pcout;
 
 };
 
@@ -1,7 +1,10 @@
+#include <deal.II/base/mpi.h>
+
 #include "poisson.h"
 
 
-int main() {
+int main(int argc, char *argv[]) {
+    Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
     std::cout << "PoissonNitsche" << std::endl;
     {
         PoissonNitsche<2> poisson(1, 6);
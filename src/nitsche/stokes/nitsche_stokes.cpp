@@ -1,13 +1,14 @@
 #include <deal.II/base/logstream.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/utilities.h>
 
-#include <deal.II/lac/block_vector.h>
-#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/block_sparsity_pattern.h>
 #include <deal.II/lac/full_matrix.h>
-#include <deal.II/lac/precondition.h>
-#include <deal.II/lac/sparse_direct.h>
-#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_minres.h>
+#include <deal.II/lac/sparsity_tools.h>
 #include <deal.II/lac/vector.h>
 
 #include <deal.II/grid/grid_generator.h>
@@ -39,6 +40,29 @@ namespace Stokes {
     using namespace dealii;
 
 
+    /**
+     * Apply the preconditioners of the velocity and the pressure block on
+     * the diagonal, as in step-55.
+     */
+    template<class PreconditionerA, class PreconditionerS>
+    class BlockDiagonalPreconditioner : public Subscriptor {
+    public:
+        BlockDiagonalPreconditioner(const PreconditionerA &preconditioner_A,
+                                    const PreconditionerS &preconditioner_S)
+                : preconditioner_A(preconditioner_A),
+                  preconditioner_S(preconditioner_S) {}
+
+        void vmult(LA::MPI::BlockVector &dst, const LA::MPI::BlockVector &src) const {
+            preconditioner_A.vmult(dst.block(0), src.block(0));
+            preconditioner_S.vmult(dst.block(1), src.block(1));
+        }
+
+    private:
+        const PreconditionerA &preconditioner_A;
+        const PreconditionerS &preconditioner_S;
+    };
+
+
     template<int dim>
     double RightHandSide<dim>::point_value(const Point<dim> &p, const unsigned int) const {
         (void) p;
@@ -90,11 +114,18 @@ namespace Stokes {
 
     template<int dim>
     StokesNitsche<dim>::StokesNitsche(const unsigned int degree, RightHandSide<dim> &rhs, BoundaryValues<dim> &bdd_val,
-                                      const unsigned int do_nothing_bdd_id)
-            : degree(degree),
+                                      const unsigned int do_nothing_bdd_id,
+                                      const MPI_Comm &mpi_communicator)
+            : degree(degree), mpi_communicator(mpi_communicator),
+              triangulation(mpi_communicator,
+                            typename Triangulation<dim>::MeshSmoothing(
+                                    Triangulation<dim>::smoothing_on_refinement |
+                                    Triangulation<dim>::smoothing_on_coarsening)),
               fe(FESystem<dim>(FE_Q<dim>(degree + 1), dim), 1, FE_Q<dim>(degree),
                  1), // u (with dim components), p (scalar component)
-              dof_handler(triangulation), do_nothing_bdd_id(do_nothing_bdd_id) {
+              dof_handler(triangulation), do_nothing_bdd_id(do_nothing_bdd_id),
+              pcout(std::cout,
+                    Utilities::MPI::this_mpi_process(mpi_communicator) == 0) {
         right_hand_side = &rhs;
         boundary_values = &bdd_val;
     }
@@ -108,47 +139,95 @@ namespace Stokes {
 
     template<int dim>
     void StokesNitsche<dim>::output_grid() {
-        // Write svg of grid to file.
-        if (dim == 2) {
-            std::ofstream out("nitsche-stokes-grid.svg");
+        // Each process only knows its own part of the distributed mesh, so
+        // the grid is only written for serial runs.
+        if (Utilities::MPI::n_mpi_processes(mpi_communicator) == 1) {
+            // Write svg of grid to file.
+            if (dim == 2) {
+                std::ofstream out("nitsche-stokes-grid.svg");
+                GridOut grid_out;
+                grid_out.write_svg(triangulation, out);
+                std::cout << "  Grid written to file as svg." << std::endl;
+            }
+            std::ofstream out_vtk("nitsche-stokes-grid.vtk");
             GridOut grid_out;
-            grid_out.write_svg(triangulation, out);
-            std::cout << "  Grid written to file as svg." << std::endl;
+            grid_out.write_vtk(triangulation, out_vtk);
+            std::cout << "  Grid written to file as vtk." << std::endl;
         }
-        std::ofstream out_vtk("nitsche-stokes-grid.vtk");
-        GridOut grid_out;
-        grid_out.write_vtk(triangulation, out_vtk);
-        std::cout << "  Grid written to file as vtk." << std::endl;
 
-        std::cout << "  Number of active cells: " << triangulation.n_active_cells() << std::endl;
+        pcout << "  Number of active cells: " << triangulation.n_global_active_cells() << std::endl;
     }
 
     template<int dim>
     void StokesNitsche<dim>::setup_dofs() {
         dof_handler.distribute_dofs(fe);
-        DoFRenumbering::Cuthill_McKee(dof_handler);
-        DoFRenumbering::component_wise(dof_handler);  // TODO hva gjør denne?
+
+        // Sort the dofs with all the velocity components in block 0, and the
+        // pressure in block 1.
+        std::vector<unsigned int> block_component(dim + 1, 0);
+        block_component[dim] = 1;
+        DoFRenumbering::component_wise(dof_handler, block_component);
 
         const std::vector<types::global_dof_index> dofs_per_block =
-                DoFTools::count_dofs_per_fe_block(dof_handler);
+                DoFTools::count_dofs_per_fe_block(dof_handler, block_component);
         const unsigned int n_u = dofs_per_block[0];
         const unsigned int n_p = dofs_per_block[1];
-        std::cout << "  Number of active cells: " << triangulation.n_active_cells() << std::endl
-                  << "  Number of degrees of freedom: " << dof_handler.n_dofs()
-                  << " (" << n_u << " + " << n_p << ')' << std::endl;
-
-        DynamicSparsityPattern dsp(dof_handler.n_dofs(), dof_handler.n_dofs());
-        DoFTools::make_sparsity_pattern(dof_handler, dsp);
-        sparsity_pattern.copy_from(dsp);
-        system_matrix.reinit(sparsity_pattern);
+        pcout << "  Number of active cells: " << triangulation.n_global_active_cells() << std::endl
+              << "  Number of degrees of freedom: " << dof_handler.n_dofs()
+              << " (" << n_u << " + " << n_p << ')' << std::endl;
+
+        const IndexSet &locally_owned_dofs = dof_handler.locally_owned_dofs();
+        IndexSet locally_relevant_dofs;
+        DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant_dofs);
+
+        owned_partitioning.resize(2);
+        owned_partitioning[0] = locally_owned_dofs.get_view(0, n_u);
+        owned_partitioning[1] = locally_owned_dofs.get_view(n_u, n_u + n_p);
+        relevant_partitioning.resize(2);
+        relevant_partitioning[0] = locally_relevant_dofs.get_view(0, n_u);
+        relevant_partitioning[1] = locally_relevant_dofs.get_view(n_u, n_u + n_p);
+
+        constraints.clear();
+        constraints.reinit(locally_relevant_dofs);
+        constraints.close();
+
+        {
+            // The system has no pressure-pressure coupling.
+            Table<2, DoFTools::Coupling> coupling(dim + 1, dim + 1);
+            for (unsigned int c = 0; c < dim + 1; ++c) {
+                for (unsigned int d = 0; d < dim + 1; ++d) {
+                    coupling[c][d] = (c == dim && d == dim) ? DoFTools::none : DoFTools::always;
+                }
+            }
+            BlockDynamicSparsityPattern dsp(relevant_partitioning);
+            DoFTools::make_sparsity_pattern(dof_handler, coupling, dsp, constraints, false);
+            SparsityTools::distribute_sparsity_pattern(dsp, locally_owned_dofs,
+                                                       mpi_communicator, locally_relevant_dofs);
+            system_matrix.reinit(owned_partitioning, dsp, mpi_communicator);
+        }
+        {
+            // The preconditioner matrix only holds the pressure mass matrix.
+            Table<2, DoFTools::Coupling> coupling(dim + 1, dim + 1);
+            for (unsigned int c = 0; c < dim + 1; ++c) {
+                for (unsigned int d = 0; d < dim + 1; ++d) {
+                    coupling[c][d] = (c == dim && d == dim) ? DoFTools::always : DoFTools::none;
+                }
+            }
+            BlockDynamicSparsityPattern dsp(relevant_partitioning);
+            DoFTools::make_sparsity_pattern(dof_handler, coupling, dsp, constraints, false);
+            SparsityTools::distribute_sparsity_pattern(dsp, locally_owned_dofs,
+                                                       mpi_communicator, locally_relevant_dofs);
+            preconditioner_matrix.reinit(owned_partitioning, dsp, mpi_communicator);
+        }
 
-        solution.reinit(dof_handler.n_dofs());
-        system_rhs.reinit(dof_handler.n_dofs());
+        solution.reinit(owned_partitioning, relevant_partitioning, mpi_communicator);
+        system_rhs.reinit(owned_partitioning, mpi_communicator);
     }
 
     template<int dim>
     void StokesNitsche<dim>::assemble_system() {
         system_matrix = 0;
+        preconditioner_matrix = 0;
         system_rhs = 0;
 
         QGauss<dim> quadrature_formula(fe.degree + 2);  // TODO degree+1 eller +2?
@@ -170,7 +249,9 @@ namespace Stokes {
 
         // Matrix and vector for the contribution of each cell
         FullMatrix<double> local_matrix(dofs_per_cell, dofs_per_cell);
+        FullMatrix<double> local_preconditioner_matrix(dofs_per_cell, dofs_per_cell);
         Vector<double> local_rhs(dofs_per_cell);
+        std::vector<types::global_dof_index> local_dof_indices(dofs_per_cell);
 
         // Vector for values of the RightHandSide for all quadrature points on a cell.
         std::vector<Tensor<1, dim>>
@@ -193,8 +274,12 @@ namespace Stokes {
         Tensor<1, dim> x_q;
 
         for (const auto &cell : dof_handler.active_cell_iterators()) {
+            if (!cell->is_locally_owned()) {
+                continue;
+            }
             fe_values.reinit(cell);
             local_matrix = 0;
+            local_preconditioner_matrix = 0;
             local_rhs = 0;
 
             // Get the values for the RightHandSide for all quadrature points in this cell.
@@ -218,6 +303,9 @@ namespace Stokes {
                                  - (div_phi_u[j] * phi_p[i])    // -(div v, p)
                                  - (div_phi_u[i] * phi_p[j])    // -(div u, q)
                                 ) * fe_values.JxW(q);           // dx
+                        local_preconditioner_matrix(i, j) +=
+                                phi_p[i] * phi_p[j]             // (p, q)
+                                * fe_values.JxW(q);             // dx
                     }
                     // RHS
                     local_rhs(i) +=
@@ -271,26 +359,45 @@ namespace Stokes {
                 }
             }
 
-            std::vector<types::global_dof_index> local_dof_indices(dofs_per_cell);
             cell->get_dof_indices(local_dof_indices);
-
-            for (unsigned int i = 0; i < dofs_per_cell; ++i) {
-                for (unsigned int j = 0; j < dofs_per_cell; ++j) {
-                    system_matrix.add(local_dof_indices[i],
-                                      local_dof_indices[j],
-                                      local_matrix(i, j));
-                }
-                system_rhs(local_dof_indices[i]) += local_rhs(i);
-            }
+            constraints.distribute_local_to_global(local_matrix, local_rhs, local_dof_indices,
+                                                   system_matrix, system_rhs);
+            constraints.distribute_local_to_global(local_preconditioner_matrix, local_dof_indices,
+                                                   preconditioner_matrix);
         }
+
+        system_matrix.compress(VectorOperation::add);
+        preconditioner_matrix.compress(VectorOperation::add);
+        system_rhs.compress(VectorOperation::add);
     }
 
     template<int dim>
     void StokesNitsche<dim>::solve() {
-        // TODO annen løser? Løs på blokk-form?
-        SparseDirectUMFPACK inverse;
-        inverse.initialize(system_matrix);
-        inverse.vmult(solution, system_rhs);
+        LA::MPI::PreconditionAMG::AdditionalData data;
+#ifdef USE_PETSC_LA
+        data.symmetric_operator = true;
+#else
+        data.elliptic = true;
+        data.higher_order_elements = true;
+#endif
+        // One V-cycle for the velocity block, and one for the pressure mass
+        // matrix, which is spectrally equivalent to the Schur complement
+        // (the viscosity is 1).
+        LA::MPI::PreconditionAMG preconditioner_A;
+        preconditioner_A.initialize(system_matrix.block(0, 0), data);
+        LA::MPI::PreconditionAMG preconditioner_S;
+        preconditioner_S.initialize(preconditioner_matrix.block(1, 1), data);
+
+        const BlockDiagonalPreconditioner<LA::MPI::PreconditionAMG, LA::MPI::PreconditionAMG>
+                preconditioner(preconditioner_A, preconditioner_S);
+
+        LA::MPI::BlockVector distributed_solution(owned_partitioning, mpi_communicator);
+        SolverControl solver_control(system_matrix.m(), 1e-10 * system_rhs.l2_norm());
+        SolverMinRes<LA::MPI::BlockVector> solver(solver_control);
+        solver.solve(system_matrix, distributed_solution, system_rhs, preconditioner);
+        pcout << "  Solved in " << solver_control.last_step() << " MINRES iterations." << std::endl;
+
+        solution = distributed_solution;
     }
 
     template<int dim>
@@ -307,10 +414,15 @@ namespace Stokes {
         data_out.attach_dof_handler(dof_handler);
         data_out.add_data_vector(solution, solution_names, DataOut<dim>::type_dof_data, dci);
 
+        Vector<float> subdomain(triangulation.n_active_cells());
+        for (unsigned int i = 0; i < subdomain.size(); ++i) {
+            subdomain(i) = triangulation.locally_owned_subdomain();
+        }
+        data_out.add_data_vector(subdomain, "subdomain");
+
         data_out.build_patches();
-        std::ofstream output("nitsche-stokes.vtk");
-        data_out.write_vtk(output);
-        std::cout << "  Output written to .vtk file." << std::endl;
+        data_out.write_vtu_with_pvtu_record("", "nitsche-stokes", 0, mpi_communicator, 2, 8);
+        pcout << "  Output written to .vtu files." << std::endl;
     }
 
     template<int dim>
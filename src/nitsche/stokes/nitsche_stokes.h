@@ -1,9 +1,13 @@
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/tensor_function.h>
-#include <deal.II/lac/vector.h>
-#include <deal.II/lac/sparse_matrix.h>
-#include <deal.II/grid/tria.h>
+#include <deal.II/distributed/tria.h>
 #include <deal.II/dofs/dof_handler.h>
 #include <deal.II/fe/fe_system.h>
+#include <deal.II/lac/affine_constraints.h>
+
+#include "../linear_algebra.h"
 
 
 using namespace dealii;
@@ -35,11 +39,23 @@ namespace Stokes {
     };
 
 
+    /**
+     * The Stokes equations on a fitted mesh, with the Dirichlet boundary
+     * conditions imposed weakly by Nitsche's method. This is used as a
+     * reference solution for the CutFEM solvers.
+     *
+     * The mesh is a parallel::distributed::Triangulation, and the dofs are
+     * sorted in a velocity and a pressure block. The symmetric saddle point
+     * system is solved with MINRES, preconditioned with a block diagonal
+     * preconditioner: AMG for the velocity block, and AMG for the pressure
+     * mass matrix as an approximation of the Schur complement.
+     */
     template<int dim>
     class StokesNitsche {
     public:
         StokesNitsche(const unsigned int degree, RightHandSide<dim> &rhs, BoundaryValues<dim> &bdd_val,
-                      unsigned int do_nothing_bdd_id=1);
+                      unsigned int do_nothing_bdd_id=1,
+                      const MPI_Comm &mpi_communicator = MPI_COMM_WORLD);
 
         virtual void run();
 
@@ -57,16 +73,30 @@ namespace Stokes {
         void output_results() const;
 
         const unsigned int degree;
-        Triangulation<dim> triangulation;
+        MPI_Comm mpi_communicator;
+        parallel::distributed::Triangulation<dim> triangulation;
         FESystem<dim> fe;
         DoFHandler<dim> dof_handler;
         RightHandSide<dim> *right_hand_side;
         BoundaryValues<dim> *boundary_values;
         const unsigned int do_nothing_bdd_id;
 
-        SparsityPattern sparsity_pattern;
-        SparseMatrix<double> system_matrix;
-        Vector<double> solution;
-        Vector<double> system_rhs;
+        // The locally owned and relevant dofs of the velocity and the
+        // pressure block.
+        std::vector<IndexSet> owned_partitioning;
+        std::vector<IndexSet> relevant_partitioning;
+        // No strong constraints are used, since the boundary conditions are
+        // imposed weakly.
+        AffineConstraints<double> constraints;
+
+        LA::MPI::BlockSparseMatrix system_matrix;
+        // The pressure mass matrix in the (1, 1)-block, used to precondition
+        // the Schur complement.
+        LA::MPI::BlockSparseMatrix preconditioner_matrix;
+        // The solution with ghost elements, used for output and errors.
+        LA::MPI::BlockVector solution;
+        LA::MPI::BlockVector system_rhs;
+
+        ConditionalOStream pcout;
     };
 }
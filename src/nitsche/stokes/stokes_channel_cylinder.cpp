@@ -1,7 +1,11 @@
 #include <iostream>
+
+#include <deal.II/base/mpi.h>
+
 #include "nitsche_stokes.h"
 
-int main() {
+int main(int argc, char *argv[]) {
+    Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
     std::cout << "StokesNitsche" << std::endl;
     {
         using namespace Stokes;
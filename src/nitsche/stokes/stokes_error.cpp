@@ -1,6 +1,7 @@
 #include <deal.II/base/tensor_function.h>
 #include <deal.II/grid/grid_generator.h>
 #include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
 #include <deal.II/numerics/vector_tools.h>
 #include <deal.II/fe/fe_values.h>
 
@@ -128,8 +129,15 @@ namespace Error {
 
     template<int dim>
     void StokesError<dim>::make_grid() {
-        GridGenerator::cylinder(this->triangulation, radius, -left_boundary);
-        GridTools::remove_anisotropy(this->triangulation, 1.618, 5);
+        // The distributed triangulation does not support the anisotropic
+        // refinement done by remove_anisotropy, so the coarse mesh is made on
+        // a serial triangulation, and its active cells are then copied as the
+        // coarse cells of the distributed one (with the boundary ids).
+        Triangulation<dim> serial_triangulation;
+        GridGenerator::cylinder(serial_triangulation, radius, -left_boundary);
+        GridTools::remove_anisotropy(serial_triangulation, 1.618, 5);
+        GridGenerator::flatten_triangulation(serial_triangulation,
+                                             this->triangulation);
         this->triangulation.refine_global(dim == 2 ? 4 : 0);
     }
 
@@ -157,7 +165,7 @@ namespace Error {
                                                                     cellwise_errors,
                                                                     VectorTools::L2_norm);
 
-        std::cout << "  Errors: ||e_p||_L2 = " << u_l2_error << std::endl;
+        this->pcout << "  Errors: ||e_p||_L2 = " << u_l2_error << std::endl;
     }
 
     template<int dim>
@@ -169,7 +177,8 @@ namespace Error {
 }
 
 
-int main() {
+int main(int argc, char *argv[]) {
+    Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
     using namespace Error;
 
     std::cout << "StokesError" << std::endl;